@@ -4,6 +4,9 @@ file(GLOB_RECURSE VERTEX_SHADERS "${SHADER_SOURCE_DIR}/*.vert")
 file(GLOB_RECURSE FRAGMENT_SHADERS "${SHADER_SOURCE_DIR}/*.frag")
 file(GLOB_RECURSE COMPUTE_SHADERS "${SHADER_SOURCE_DIR}/*.comp")
 
+# Shared includes, every shader is rebuilt when one of them changes
+file(GLOB_RECURSE SHADER_INCLUDES "${SHADER_SOURCE_DIR}/*.glsl")
+
 set(ALL_SHADERS
     ${VERTEX_SHADERS}
     ${FRAGMENT_SHADERS}
@@ -31,7 +34,7 @@ foreach(SHADER_SOURCE IN LISTS ALL_SHADERS)
     add_custom_command(
         OUTPUT "${SHADER_SPV}"
         COMMAND "${GLSLC_EXECUTABLE}" -fshader-stage=${SHADER_STAGE} "${SHADER_SOURCE}" -o "${SHADER_SPV}"
-        DEPENDS "${SHADER_SOURCE}"
+        DEPENDS "${SHADER_SOURCE}" ${SHADER_INCLUDES}
         COMMENT "Compiling shader ${SHADER_SOURCE}"
         VERBATIM
     )
@@ -1,7 +1,9 @@
 #version 450
 
+// Per-quad instance data, corners are expanded from gl_VertexIndex
 layout(location = 0) in vec2 in_position;
-layout(location = 1) in vec4 in_color;
+layout(location = 1) in vec2 in_size;
+layout(location = 2) in uint in_color;
 
 layout(location = 0) out vec4 out_color;
 
@@ -10,8 +12,20 @@ layout (set = 0, binding = 0) buffer UBO
     mat4 viewProjection;
 };
 
+// Two triangles over bottom-left, bottom-right, top-right, top-left: (0, 1, 2) and (2, 3, 0)
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5),
+    vec2( 0.5, -0.5),
+    vec2( 0.5,  0.5),
+    vec2( 0.5,  0.5),
+    vec2(-0.5,  0.5),
+    vec2(-0.5, -0.5)
+);
+
 void main()
 {
-    out_color = in_color;
-    gl_Position = viewProjection * vec4(in_position, 0.0, 1.0);
+    vec2 position = in_position + corners[gl_VertexIndex] * in_size;
+
+    out_color = unpackUnorm4x8(in_color);
+    gl_Position = viewProjection * vec4(position, 0.0, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#version 450
+
+// Compact per-quad instance data (12 bytes), formats are picked from the input name suffixes
+layout(location = 0) in vec2 in_position_half;
+layout(location = 1) in vec2 in_size_half;
+layout(location = 2) in vec4 in_color_unorm8;
+
+layout(location = 0) out vec4 out_color;
+
+layout (set = 0, binding = 0) buffer UBO
+{
+    mat4 viewProjection;
+};
+
+// Two triangles over bottom-left, bottom-right, top-right, top-left: (0, 1, 2) and (2, 3, 0)
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5),
+    vec2( 0.5, -0.5),
+    vec2( 0.5,  0.5),
+    vec2( 0.5,  0.5),
+    vec2(-0.5,  0.5),
+    vec2(-0.5, -0.5)
+);
+
+void main()
+{
+    vec2 position = in_position_half + corners[gl_VertexIndex] * in_size_half;
+
+    out_color = in_color_unorm8;
+    gl_Position = viewProjection * vec4(position, 0.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#version 450
+
+// Must match ShapeType in Renderer.h
+#define SHAPE_QUAD 0u
+#define SHAPE_CIRCLE 1u
+#define SHAPE_ROUNDED_RECT 2u
+#define SHAPE_LINE 3u
+
+layout(location = 0) in vec4 in_color;
+layout(location = 1) in vec2 in_local;
+layout(location = 2) flat in uint in_shape;
+layout(location = 3) flat in vec2 in_half_size;
+layout(location = 4) flat in vec4 in_params;
+
+layout(location = 0) out vec4 out_color;
+
+// Signed distances in world units, negative inside
+float circle_distance(vec2 p, float radius)
+{
+    return length(p) - radius;
+}
+
+float rounded_rect_distance(vec2 p, vec2 half_size, float radius)
+{
+    radius = min(radius, min(half_size.x, half_size.y));
+    vec2 q = abs(p) - half_size + radius;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+}
+
+float segment_distance(vec2 p, vec2 half_segment, float thickness)
+{
+    vec2 pa = p + half_segment;
+    vec2 ba = half_segment * 2.0;
+    float t = clamp(dot(pa, ba) / max(dot(ba, ba), 1e-8), 0.0, 1.0);
+    return length(pa - ba * t) - thickness * 0.5;
+}
+
+void main()
+{
+    if (in_shape == SHAPE_QUAD)
+    {
+        out_color = in_color;
+        return;
+    }
+
+    float distance;
+    if (in_shape == SHAPE_CIRCLE)
+    {
+        distance = circle_distance(in_local, min(in_half_size.x, in_half_size.y));
+    }
+    else if (in_shape == SHAPE_ROUNDED_RECT)
+    {
+        distance = rounded_rect_distance(in_local, in_half_size, in_params.y);
+    }
+    else
+    {
+        distance = segment_distance(in_local, in_params.zw, in_params.x);
+    }
+
+    // Outline: keep a band of the given width just inside the edge
+    float outline = in_params.x;
+    if (outline > 0.0 && in_shape != SHAPE_LINE)
+    {
+        distance = abs(distance + outline * 0.5) - outline * 0.5;
+    }
+
+    // One pixel of coverage falloff on the inside of the edge, so the quad never clips it
+    float pixel = max(fwidth(distance), 1e-6);
+    float coverage = clamp(-distance / pixel, 0.0, 1.0);
+    if (coverage <= 0.0)
+    {
+        discard;
+    }
+
+    out_color = vec4(in_color.rgb, in_color.a * coverage);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#version 450
+
+// Per-shape instance data, the fragment shader turns each quad into one analytic shape
+layout(location = 0) in vec2 in_position;
+layout(location = 1) in vec2 in_size;
+layout(location = 2) in uint in_color;
+layout(location = 3) in uint in_shape;
+layout(location = 4) in vec4 in_params;
+
+layout(location = 0) out vec4 out_color;
+layout(location = 1) out vec2 out_local;
+layout(location = 2) flat out uint out_shape;
+layout(location = 3) flat out vec2 out_half_size;
+layout(location = 4) flat out vec4 out_params;
+
+layout (set = 0, binding = 0) buffer UBO
+{
+    mat4 viewProjection;
+};
+
+// Two triangles over bottom-left, bottom-right, top-right, top-left: (0, 1, 2) and (2, 3, 0)
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5),
+    vec2( 0.5, -0.5),
+    vec2( 0.5,  0.5),
+    vec2( 0.5,  0.5),
+    vec2(-0.5,  0.5),
+    vec2(-0.5, -0.5)
+);
+
+void main()
+{
+    vec2 local = corners[gl_VertexIndex] * in_size;
+
+    out_color = unpackUnorm4x8(in_color);
+    out_local = local;
+    out_shape = in_shape;
+    out_half_size = in_size * 0.5;
+    out_params = in_params;
+    gl_Position = viewProjection * vec4(in_position + local, 0.0, 1.0);
+}
\ No newline at end of file
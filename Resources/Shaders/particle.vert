@@ -0,0 +1,45 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+#include "particle_common.glsl"
+
+// Live particles are pulled straight from the simulation buffers, one quad per instance
+layout(location = 0) out vec4 out_color;
+
+layout (set = 0, binding = 0) readonly buffer UBO
+{
+    mat4 viewProjection;
+};
+
+layout (set = 0, binding = 1) readonly buffer ParticleBuffer
+{
+    Particle particles[];
+};
+
+layout (set = 0, binding = 2) readonly buffer AliveListBuffer
+{
+    uint alive_list[];
+};
+
+layout (set = 0, binding = 3) readonly buffer PoolStateBuffer
+{
+    ParticlePoolState state;
+};
+
+// Two triangles over bottom-left, bottom-right, top-right, top-left: (0, 1, 2) and (2, 3, 0)
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5),
+    vec2( 0.5, -0.5),
+    vec2( 0.5,  0.5),
+    vec2( 0.5,  0.5),
+    vec2(-0.5,  0.5),
+    vec2(-0.5, -0.5)
+);
+
+void main()
+{
+    Particle p = particles[alive_list[state.draw_list_offset + gl_InstanceIndex]];
+    vec2 position = p.position + corners[gl_VertexIndex] * p.size;
+
+    out_color = p.color;
+    gl_Position = viewProjection * vec4(position, 0.0, 1.0);
+}
\ No newline at end of file
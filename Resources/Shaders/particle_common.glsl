@@ -0,0 +1,80 @@
+// Shared particle declarations, included by the particle compute and vertex shaders
+
+struct Particle
+{
+    vec2 position;
+    vec2 velocity;
+    vec4 color;
+    float lifetime;
+    float size;
+    uint emitter; // emitter table index
+    float padding;
+};
+
+// Must match ParticlePoolState in ParticleSystem.h
+struct ParticlePoolState
+{
+    uint alive_count[2]; // live particles in each alive list
+    uint dead_count;     // free slots on the dead list stack
+    uint emit_count;     // particles spawned this frame
+    uint draw_list_offset;
+    uint padding[3];
+};
+
+// Must match ParticleIndirectArgs in ParticleSystem.h
+struct ParticleIndirectArgs
+{
+    uint emit_dispatch[3];
+    uint simulate_dispatch[3];
+    uint draw[4]; // num_vertices, num_instances, first_vertex, first_instance
+};
+
+// Must match EmitterData in ParticleSystem.h (std430)
+struct EmitterData
+{
+    vec2 position;
+    float gravity;
+    float damping;
+    uint spawn_offset; // this emitter spawns indices spawn_offset .. spawn_offset + spawn_count - 1
+    uint spawn_count;
+    uint seed;
+    uint spawn_base; // particles the emitter spawned before this frame, numbers its spawns
+    float depth;     // 0 front .. 1 back, only used to order the draw
+    uint layer;      // drawn in ascending layer order, before depth
+};
+
+// Must match ParticleSystemParams in ParticleSystem.h (std140)
+struct SystemParams
+{
+    float delta_time;
+    uint particle_count;
+    uint emitter_count;
+    uint spawn_count; // over all emitters
+    uint alive_list;  // alive list simulated this frame, survivors go to the other one
+    uint padding0;
+    uint padding1;
+    uint padding2;
+};
+
+// Philox 2x32-10 counter-based generator, the same (counter, key) always gives the same two words.
+// Must match particle_random in ParticleCpu.c bit for bit
+uvec2 philox2x32(uvec2 counter, uint key)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        uint high;
+        uint low;
+        umulExtended(0xD256D193u, counter.x, high, low);
+        counter = uvec2(high ^ key ^ counter.y, low);
+        key += 0x9E3779B9u;
+    }
+    return counter;
+}
+
+// Two uniform floats in [0, 1) for draw pair `draw` of spawn number `spawn` of the emitter with
+// `seed`. 24 bits per float keep the conversion exact on every backend
+vec2 particle_random(uint seed, uint spawn, uint draw)
+{
+    uvec2 words = philox2x32(uvec2(spawn, draw), seed);
+    return vec2(words >> 8u) * (1.0 / 16777216.0);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+// Uniform grid spatial hash over the live particles, included by the grid passes
+
+// Must match ParticleGridParams in ParticleGrid.c (std140)
+struct GridParams
+{
+    float cell_size;     // at least the interaction radius, so neighbors sit in the 3x3 cells around
+    float radius;
+    float separation;
+    float cohesion;
+    float alignment;
+    float delta_time;
+    uint cell_count;     // hash buckets, a power of two
+    uint particle_count;
+    uint alive_list;     // alive list holding this update's survivors
+    uint max_neighbors;  // neighbors visited per particle, bounds the cost of dense clusters
+    uint padding0;
+    uint padding1;
+};
+
+ivec2 grid_cell(vec2 position, float cell_size)
+{
+    return ivec2(floor(position / cell_size));
+}
+
+// Unbounded cells fold into the buckets, colliding cells share a range and are told apart
+// by the distance test of the query
+uint grid_hash(ivec2 cell, uint cell_count)
+{
+    return ((uint(cell.x) * 73856093u) ^ (uint(cell.y) * 19349663u)) & (cell_count - 1u);
+}
\ No newline at end of file
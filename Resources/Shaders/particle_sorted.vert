@@ -0,0 +1,40 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+#include "particle_common.glsl"
+
+// Sorted live particles, instance i draws the particle at position i of the sorted index list
+layout(location = 0) out vec4 out_color;
+
+layout (set = 0, binding = 0) readonly buffer UBO
+{
+    mat4 viewProjection;
+};
+
+layout (set = 0, binding = 1) readonly buffer ParticleBuffer
+{
+    Particle particles[];
+};
+
+layout (set = 0, binding = 2) readonly buffer SortedIndexBuffer
+{
+    uint sorted_indices[];
+};
+
+// Two triangles over bottom-left, bottom-right, top-right, top-left: (0, 1, 2) and (2, 3, 0)
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5),
+    vec2( 0.5, -0.5),
+    vec2( 0.5,  0.5),
+    vec2( 0.5,  0.5),
+    vec2(-0.5,  0.5),
+    vec2(-0.5, -0.5)
+);
+
+void main()
+{
+    Particle p = particles[sorted_indices[gl_InstanceIndex]];
+    vec2 position = p.position + corners[gl_VertexIndex] * p.size;
+
+    out_color = p.color;
+    gl_Position = viewProjection * vec4(position, 0.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+// Shared by the radix sort passes, must match GpuSort.h
+
+// Every workgroup sorts one tile of 256 threads x 4 pairs, 4 key bits per pass
+#define SORT_THREADS 256u
+#define SORT_ELEMENTS_PER_THREAD 4u
+#define SORT_TILE_SIZE (SORT_THREADS * SORT_ELEMENTS_PER_THREAD)
+#define SORT_RADIX_BITS 4u
+#define SORT_RADIX (1u << SORT_RADIX_BITS)
+
+// Must match GpuSortParams in GpuSort.c (std140)
+struct SortParams
+{
+    uint count_index; // word of the count buffer that holds the number of pairs
+    uint shift;       // lowest key bit sorted by this pass
+    uint capacity;    // counts above this are clamped
+    uint padding;
+};
+
+uint sort_tile_count(uint count)
+{
+    return (count + SORT_TILE_SIZE - 1u) / SORT_TILE_SIZE;
+}
+
+uint sort_digit(uint key, uint shift)
+{
+    return (key >> shift) & (SORT_RADIX - 1u);
+}
\ No newline at end of file
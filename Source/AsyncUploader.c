@@ -0,0 +1,393 @@
+#include "AsyncUploader.h"
+
+#include <stdlib.h>
+
+static void async_uploader_complete(AsyncUploader *uploader, UploadTicket ticket)
+{
+    SDL_LockMutex(uploader->mutex);
+    if (ticket > uploader->completed_ticket)
+    {
+        uploader->completed_ticket = ticket;
+    }
+    SDL_BroadcastCondition(uploader->ticket_completed);
+    SDL_UnlockMutex(uploader->mutex);
+}
+
+static void async_uploader_retire_chunks(AsyncUploader *uploader, bool wait)
+{
+    SDL_GPUFence *fences[ASYNC_UPLOAD_CHUNKS_IN_FLIGHT];
+    uint32_t fence_count = 0;
+
+    for (uint32_t i = 0; i < ASYNC_UPLOAD_CHUNKS_IN_FLIGHT; i++)
+    {
+        if (uploader->chunks[i].fence)
+        {
+            fences[fence_count++] = uploader->chunks[i].fence;
+        }
+    }
+
+    if (fence_count == 0)
+    {
+        return;
+    }
+
+    if (wait)
+    {
+        SDL_WaitForGPUFences(uploader->device, false, fences, fence_count);
+    }
+
+    // Submissions retire in order, so the highest finished ticket implies all earlier ones
+    UploadTicket completed = UPLOAD_TICKET_INVALID;
+    for (uint32_t i = 0; i < ASYNC_UPLOAD_CHUNKS_IN_FLIGHT; i++)
+    {
+        AsyncUploadChunk *chunk = &uploader->chunks[i];
+        if (chunk->fence && SDL_QueryGPUFence(uploader->device, chunk->fence))
+        {
+            SDL_ReleaseGPUFence(uploader->device, chunk->fence);
+            chunk->fence = NULL;
+            uploader->chunks_in_flight--;
+
+            if (chunk->ticket > completed)
+            {
+                completed = chunk->ticket;
+            }
+        }
+    }
+
+    if (completed != UPLOAD_TICKET_INVALID)
+    {
+        async_uploader_complete(uploader, completed);
+    }
+}
+
+static void async_uploader_pop_job(AsyncUploader *uploader, AsyncUploadJob *job)
+{
+    if (job->free_when_done)
+    {
+        free(job->data);
+    }
+    job->data = NULL;
+
+    SDL_LockMutex(uploader->mutex);
+    uploader->job_head = (uploader->job_head + 1) % ASYNC_UPLOAD_MAX_JOBS;
+    uploader->job_count--;
+    SDL_UnlockMutex(uploader->mutex);
+}
+
+static void async_uploader_abort_job(AsyncUploader *uploader, AsyncUploadJob *job)
+{
+    // Drain earlier chunks first so tickets keep completing in order
+    while (uploader->chunks_in_flight > 0)
+    {
+        async_uploader_retire_chunks(uploader, true);
+    }
+
+    UploadTicket ticket = job->ticket;
+    async_uploader_pop_job(uploader, job);
+
+    // Recorded before completing, so a caller woken by the ticket already sees the failure
+    SDL_LockMutex(uploader->mutex);
+    uploader->failed_tickets[uploader->failed_count % ASYNC_UPLOAD_MAX_FAILED] = ticket;
+    uploader->failed_count++;
+    SDL_UnlockMutex(uploader->mutex);
+
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Async upload %u failed", ticket);
+    async_uploader_complete(uploader, ticket);
+}
+
+static void async_uploader_stage_chunk(AsyncUploader *uploader, AsyncUploadJob *job)
+{
+    AsyncUploadChunk *chunk = NULL;
+    for (uint32_t i = 0; i < ASYNC_UPLOAD_CHUNKS_IN_FLIGHT; i++)
+    {
+        if (!uploader->chunks[i].fence)
+        {
+            chunk = &uploader->chunks[i];
+            break;
+        }
+    }
+
+    if (!chunk)
+    {
+        return;
+    }
+
+    uint32_t chunk_size = job->size - job->bytes_submitted;
+    if (chunk_size > ASYNC_UPLOAD_CHUNK_SIZE)
+    {
+        chunk_size = ASYNC_UPLOAD_CHUNK_SIZE;
+    }
+
+    // The chunk's previous copy has retired, so it can be rewritten without cycling
+    void *mapped_data = SDL_MapGPUTransferBuffer(uploader->device, chunk->transfer_buffer, false);
+    if (!mapped_data)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map async upload chunk: %s", SDL_GetError());
+        async_uploader_abort_job(uploader, job);
+        return;
+    }
+
+    SDL_memcpy(mapped_data, (const uint8_t *)job->data + job->bytes_submitted, chunk_size);
+    SDL_UnmapGPUTransferBuffer(uploader->device, chunk->transfer_buffer);
+
+    SDL_GPUCommandBuffer *upload_cmd = SDL_AcquireGPUCommandBuffer(uploader->device);
+    if (!upload_cmd)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer: %s", SDL_GetError());
+        async_uploader_abort_job(uploader, job);
+        return;
+    }
+
+    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(upload_cmd);
+
+    SDL_GPUTransferBufferLocation src_location = {0};
+    src_location.transfer_buffer = chunk->transfer_buffer;
+    src_location.offset = 0;
+
+    SDL_GPUBufferRegion dst_region = {0};
+    dst_region.buffer = job->dst_buffer;
+    dst_region.offset = job->offset + job->bytes_submitted;
+    dst_region.size = chunk_size;
+
+    SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, false);
+    SDL_EndGPUCopyPass(copy_pass);
+
+    job->bytes_submitted += chunk_size;
+    bool last_chunk = job->bytes_submitted == job->size;
+
+    chunk->fence = SDL_SubmitGPUCommandBufferAndAcquireFence(upload_cmd);
+    if (!chunk->fence)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit async upload: %s", SDL_GetError());
+        async_uploader_abort_job(uploader, job);
+        return;
+    }
+
+    chunk->ticket = last_chunk ? job->ticket : UPLOAD_TICKET_INVALID;
+    uploader->chunks_in_flight++;
+
+    if (last_chunk)
+    {
+        async_uploader_pop_job(uploader, job);
+    }
+}
+
+static int SDLCALL async_uploader_thread(void *userdata)
+{
+    AsyncUploader *uploader = (AsyncUploader *)userdata;
+
+    SDL_LockMutex(uploader->mutex);
+    for (;;)
+    {
+        while (uploader->running && uploader->job_count == 0 && uploader->chunks_in_flight == 0)
+        {
+            SDL_WaitCondition(uploader->work_available, uploader->mutex);
+        }
+
+        // Pending jobs are always finished, even when shutting down
+        if (!uploader->running && uploader->job_count == 0 && uploader->chunks_in_flight == 0)
+        {
+            break;
+        }
+
+        AsyncUploadJob *job = uploader->job_count > 0 ? &uploader->jobs[uploader->job_head] : NULL;
+        SDL_UnlockMutex(uploader->mutex);
+
+        // Only block on the GPU when there is nothing else to stage
+        bool wait = !job || uploader->chunks_in_flight == ASYNC_UPLOAD_CHUNKS_IN_FLIGHT;
+        async_uploader_retire_chunks(uploader, wait);
+
+        if (job)
+        {
+            async_uploader_stage_chunk(uploader, job);
+        }
+
+        SDL_LockMutex(uploader->mutex);
+    }
+    SDL_UnlockMutex(uploader->mutex);
+
+    return 0;
+}
+
+bool async_uploader_create(AsyncUploader *uploader, SDL_GPUDevice *device)
+{
+    if (!uploader || !device)
+    {
+        return false;
+    }
+
+    SDL_memset(uploader, 0, sizeof(AsyncUploader));
+    uploader->device = device;
+
+    uploader->mutex = SDL_CreateMutex();
+    uploader->work_available = SDL_CreateCondition();
+    uploader->ticket_completed = SDL_CreateCondition();
+    if (!uploader->mutex || !uploader->work_available || !uploader->ticket_completed)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create async uploader sync objects: %s", SDL_GetError());
+        async_uploader_destroy(uploader);
+        return false;
+    }
+
+    SDL_GPUTransferBufferCreateInfo transfer_info = {0};
+    transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    transfer_info.size = ASYNC_UPLOAD_CHUNK_SIZE;
+
+    for (uint32_t i = 0; i < ASYNC_UPLOAD_CHUNKS_IN_FLIGHT; i++)
+    {
+        uploader->chunks[i].transfer_buffer = SDL_CreateGPUTransferBuffer(device, &transfer_info);
+        if (!uploader->chunks[i].transfer_buffer)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create async upload chunk: %s", SDL_GetError());
+            async_uploader_destroy(uploader);
+            return false;
+        }
+    }
+
+    uploader->running = true;
+    uploader->thread = SDL_CreateThread(async_uploader_thread, "AsyncUploader", uploader);
+    if (!uploader->thread)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create async uploader thread: %s", SDL_GetError());
+        uploader->running = false;
+        async_uploader_destroy(uploader);
+        return false;
+    }
+
+    return true;
+}
+
+void async_uploader_destroy(AsyncUploader *uploader)
+{
+    if (!uploader || !uploader->device)
+    {
+        return;
+    }
+
+    if (uploader->thread)
+    {
+        SDL_LockMutex(uploader->mutex);
+        uploader->running = false;
+        SDL_SignalCondition(uploader->work_available);
+        SDL_UnlockMutex(uploader->mutex);
+
+        SDL_WaitThread(uploader->thread, NULL);
+        uploader->thread = NULL;
+    }
+
+    for (uint32_t i = 0; i < ASYNC_UPLOAD_CHUNKS_IN_FLIGHT; i++)
+    {
+        AsyncUploadChunk *chunk = &uploader->chunks[i];
+        if (chunk->fence)
+        {
+            SDL_ReleaseGPUFence(uploader->device, chunk->fence);
+            chunk->fence = NULL;
+        }
+
+        if (chunk->transfer_buffer)
+        {
+            SDL_ReleaseGPUTransferBuffer(uploader->device, chunk->transfer_buffer);
+            chunk->transfer_buffer = NULL;
+        }
+    }
+
+    if (uploader->ticket_completed)
+    {
+        SDL_DestroyCondition(uploader->ticket_completed);
+        uploader->ticket_completed = NULL;
+    }
+
+    if (uploader->work_available)
+    {
+        SDL_DestroyCondition(uploader->work_available);
+        uploader->work_available = NULL;
+    }
+
+    if (uploader->mutex)
+    {
+        SDL_DestroyMutex(uploader->mutex);
+        uploader->mutex = NULL;
+    }
+
+    uploader->device = NULL;
+}
+
+UploadTicket async_uploader_upload(AsyncUploader *uploader, SDL_GPUBuffer *dst_buffer, void *data, uint32_t size, uint32_t offset, bool free_when_done)
+{
+    if (!uploader || !uploader->thread || !dst_buffer || !data || size == 0)
+    {
+        return UPLOAD_TICKET_INVALID;
+    }
+
+    SDL_LockMutex(uploader->mutex);
+
+    // Back-pressure: wait for the worker to retire a job when the queue is full
+    while (uploader->job_count == ASYNC_UPLOAD_MAX_JOBS)
+    {
+        SDL_WaitCondition(uploader->ticket_completed, uploader->mutex);
+    }
+
+    AsyncUploadJob *job = &uploader->jobs[(uploader->job_head + uploader->job_count) % ASYNC_UPLOAD_MAX_JOBS];
+    job->ticket = ++uploader->last_ticket;
+    job->dst_buffer = dst_buffer;
+    job->data = data;
+    job->size = size;
+    job->offset = offset;
+    job->bytes_submitted = 0;
+    job->free_when_done = free_when_done;
+    uploader->job_count++;
+
+    UploadTicket ticket = job->ticket;
+    SDL_SignalCondition(uploader->work_available);
+    SDL_UnlockMutex(uploader->mutex);
+
+    return ticket;
+}
+
+bool async_uploader_poll(AsyncUploader *uploader, UploadTicket ticket)
+{
+    if (!uploader || !uploader->mutex || ticket == UPLOAD_TICKET_INVALID)
+    {
+        return true;
+    }
+
+    SDL_LockMutex(uploader->mutex);
+    bool completed = uploader->completed_ticket >= ticket;
+    SDL_UnlockMutex(uploader->mutex);
+
+    return completed;
+}
+
+void async_uploader_wait(AsyncUploader *uploader, UploadTicket ticket)
+{
+    if (!uploader || !uploader->mutex || ticket == UPLOAD_TICKET_INVALID)
+    {
+        return;
+    }
+
+    SDL_LockMutex(uploader->mutex);
+    while (uploader->completed_ticket < ticket)
+    {
+        SDL_WaitCondition(uploader->ticket_completed, uploader->mutex);
+    }
+    SDL_UnlockMutex(uploader->mutex);
+}
+
+bool async_uploader_failed(AsyncUploader *uploader, UploadTicket ticket)
+{
+    if (!uploader || !uploader->mutex || ticket == UPLOAD_TICKET_INVALID)
+    {
+        return false;
+    }
+
+    SDL_LockMutex(uploader->mutex);
+    bool failed = false;
+    uint32_t count = uploader->failed_count < ASYNC_UPLOAD_MAX_FAILED ? uploader->failed_count : ASYNC_UPLOAD_MAX_FAILED;
+    for (uint32_t i = 0; i < count && !failed; i++)
+    {
+        failed = uploader->failed_tickets[i] == ticket;
+    }
+    SDL_UnlockMutex(uploader->mutex);
+
+    return failed;
+}
@@ -0,0 +1,77 @@
+#ifndef _ASYNC_UPLOADER_H
+#define _ASYNC_UPLOADER_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ASYNC_UPLOAD_CHUNK_SIZE (4 * 1024 * 1024)
+#define ASYNC_UPLOAD_CHUNKS_IN_FLIGHT 3
+#define ASYNC_UPLOAD_MAX_JOBS 64
+#define ASYNC_UPLOAD_MAX_FAILED 64
+
+// Tickets are handed out in order and complete in order, 0 is never a valid ticket
+typedef uint32_t UploadTicket;
+#define UPLOAD_TICKET_INVALID 0
+
+typedef struct AsyncUploadJob
+{
+    UploadTicket ticket;
+    SDL_GPUBuffer *dst_buffer;
+    void *data;
+    uint32_t size;
+    uint32_t offset;
+    uint32_t bytes_submitted;
+    bool free_when_done;
+} AsyncUploadJob;
+
+typedef struct AsyncUploadChunk
+{
+    SDL_GPUTransferBuffer *transfer_buffer;
+    SDL_GPUFence *fence;
+    UploadTicket ticket;
+} AsyncUploadChunk;
+
+// Streams large buffer uploads in fixed-size chunks from a worker thread
+typedef struct AsyncUploader
+{
+    SDL_GPUDevice *device;
+    SDL_Thread *thread;
+    SDL_Mutex *mutex;
+    SDL_Condition *work_available;
+    SDL_Condition *ticket_completed;
+
+    AsyncUploadJob jobs[ASYNC_UPLOAD_MAX_JOBS];
+    uint32_t job_head;
+    uint32_t job_count;
+
+    AsyncUploadChunk chunks[ASYNC_UPLOAD_CHUNKS_IN_FLIGHT];
+    uint32_t chunks_in_flight;
+
+    UploadTicket last_ticket;
+    UploadTicket completed_ticket;
+
+    // Aborted tickets also complete, the most recent ASYNC_UPLOAD_MAX_FAILED are kept here
+    UploadTicket failed_tickets[ASYNC_UPLOAD_MAX_FAILED];
+    uint32_t failed_count;
+    bool running;
+} AsyncUploader;
+
+bool async_uploader_create(AsyncUploader *uploader, SDL_GPUDevice *device);
+
+// Finishes every pending upload before returning
+void async_uploader_destroy(AsyncUploader *uploader);
+
+// data must stay valid until the ticket completes, if free_when_done is set
+// the uploader releases it with free() once it has been staged
+UploadTicket async_uploader_upload(AsyncUploader *uploader, SDL_GPUBuffer *dst_buffer, void *data, uint32_t size, uint32_t offset, bool free_when_done);
+
+// True once the ticket is done, whether it uploaded or failed
+bool async_uploader_poll(AsyncUploader *uploader, UploadTicket ticket);
+void async_uploader_wait(AsyncUploader *uploader, UploadTicket ticket);
+
+// True if the ticket completed without its data reaching the buffer, e.g. when staging failed.
+// Only the last ASYNC_UPLOAD_MAX_FAILED failures are remembered
+bool async_uploader_failed(AsyncUploader *uploader, UploadTicket ticket);
+
+#endif
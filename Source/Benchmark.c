@@ -0,0 +1,582 @@
+#include "Benchmark.h"
+
+static const char *format_names[BATCH_VERTEX_FORMAT_COUNT] = { "full", "compact", "shape" };
+
+// Same sequence for every run so both formats draw identical scenes
+static float benchmark_random(uint32_t *state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return (float)(*state >> 8) / 16777216.0f;
+}
+
+static double benchmark_elapsed_ms(uint64_t start, uint64_t end)
+{
+    return (double)(end - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// Quads depend only on their index, so any split across workers gives the same batch
+static void benchmark_generate_quad(uint32_t index, Vector2f *position, Vector2f *size, Vector4f *color)
+{
+    uint32_t state = index * 747796405u + 2891336453u;
+    position->x = benchmark_random(&state) * 10.0f - 5.0f;
+    position->y = benchmark_random(&state) * 10.0f - 5.0f;
+    size->x = 0.02f;
+    size->y = 0.02f;
+    color->x = benchmark_random(&state);
+    color->y = benchmark_random(&state);
+    color->z = benchmark_random(&state);
+    color->w = 1.0f;
+}
+
+typedef struct BenchmarkWorker
+{
+    SDL_Thread *thread;
+    struct BenchmarkWorkerPool *pool;
+    BatchRange range;
+    uint32_t first_quad;
+} BenchmarkWorker;
+
+// Workers are started once per thread count and parked between iterations, so the timed
+// build never includes thread creation. Worker 0 is the benchmark thread itself
+typedef struct BenchmarkWorkerPool
+{
+    BenchmarkWorker workers[BENCHMARK_MAX_THREADS];
+    uint32_t thread_count; // builders per iteration, started threads plus the benchmark thread
+    SDL_Mutex *mutex;
+    SDL_Condition *work_available;
+    SDL_Condition *work_done;
+    uint32_t generation;
+    uint32_t busy_workers;
+    bool running;
+} BenchmarkWorkerPool;
+
+static void benchmark_fill_range(BenchmarkWorker *worker)
+{
+    Vector2f positions[BATCH_PACK_BLOCK_QUADS];
+    Vector2f sizes[BATCH_PACK_BLOCK_QUADS];
+    Vector4f colors[BATCH_PACK_BLOCK_QUADS];
+
+    for (uint32_t first = 0; first < worker->range.count; first += BATCH_PACK_BLOCK_QUADS)
+    {
+        uint32_t block = worker->range.count - first;
+        if (block > BATCH_PACK_BLOCK_QUADS)
+        {
+            block = BATCH_PACK_BLOCK_QUADS;
+        }
+
+        for (uint32_t i = 0; i < block; i++)
+        {
+            benchmark_generate_quad(worker->first_quad + first + i, &positions[i], &sizes[i], &colors[i]);
+        }
+        batch_range_write_quads(&worker->range, first, positions, sizes, colors, block);
+    }
+}
+
+static int SDLCALL benchmark_worker_thread(void *userdata)
+{
+    BenchmarkWorker *worker = (BenchmarkWorker *)userdata;
+    BenchmarkWorkerPool *pool = worker->pool;
+    uint32_t generation = 0;
+
+    SDL_LockMutex(pool->mutex);
+    for (;;)
+    {
+        while (pool->running && pool->generation == generation)
+        {
+            SDL_WaitCondition(pool->work_available, pool->mutex);
+        }
+        if (!pool->running)
+        {
+            break;
+        }
+        generation = pool->generation;
+        SDL_UnlockMutex(pool->mutex);
+
+        benchmark_fill_range(worker);
+
+        SDL_LockMutex(pool->mutex);
+        pool->busy_workers--;
+        if (pool->busy_workers == 0)
+        {
+            SDL_SignalCondition(pool->work_done);
+        }
+    }
+    SDL_UnlockMutex(pool->mutex);
+
+    return 0;
+}
+
+static void benchmark_worker_pool_stop(BenchmarkWorkerPool *pool)
+{
+    if (pool->mutex)
+    {
+        SDL_LockMutex(pool->mutex);
+        pool->running = false;
+        SDL_BroadcastCondition(pool->work_available);
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    for (uint32_t i = 1; i < pool->thread_count; i++)
+    {
+        SDL_WaitThread(pool->workers[i].thread, NULL);
+    }
+
+    SDL_DestroyCondition(pool->work_done);
+    SDL_DestroyCondition(pool->work_available);
+    SDL_DestroyMutex(pool->mutex);
+    SDL_memset(pool, 0, sizeof(BenchmarkWorkerPool));
+}
+
+// Starts thread_count - 1 workers, fewer if thread creation fails
+static bool benchmark_worker_pool_start(BenchmarkWorkerPool *pool, uint32_t thread_count)
+{
+    SDL_memset(pool, 0, sizeof(BenchmarkWorkerPool));
+    pool->mutex = SDL_CreateMutex();
+    pool->work_available = SDL_CreateCondition();
+    pool->work_done = SDL_CreateCondition();
+    if (!pool->mutex || !pool->work_available || !pool->work_done)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create benchmark worker sync: %s", SDL_GetError());
+        benchmark_worker_pool_stop(pool);
+        return false;
+    }
+
+    pool->running = true;
+    pool->thread_count = 1;
+    for (uint32_t i = 1; i < thread_count; i++)
+    {
+        BenchmarkWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->thread = SDL_CreateThread(benchmark_worker_thread, "BatchWorker", worker);
+        if (!worker->thread)
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to start benchmark worker: %s", SDL_GetError());
+            break;
+        }
+        pool->thread_count++;
+    }
+    return true;
+}
+
+// Fills every worker's range, the benchmark thread takes worker 0
+static void benchmark_worker_pool_run(BenchmarkWorkerPool *pool)
+{
+    if (pool->thread_count > 1)
+    {
+        SDL_LockMutex(pool->mutex);
+        pool->generation++;
+        pool->busy_workers = pool->thread_count - 1;
+        SDL_BroadcastCondition(pool->work_available);
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    benchmark_fill_range(&pool->workers[0]);
+
+    SDL_LockMutex(pool->mutex);
+    while (pool->busy_workers > 0)
+    {
+        SDL_WaitCondition(pool->work_done, pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+}
+
+// Uploads and retires the batch so the queue never holds copies from a destroyed renderer
+static void benchmark_flush_batch(BenchmarkContext *context)
+{
+    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(context->device);
+    if (!cmd)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer: %s", SDL_GetError());
+        return;
+    }
+
+    upload_queue_flush(context->upload_queue, cmd);
+
+    SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+    if (fence)
+    {
+        SDL_WaitForGPUFences(context->device, true, &fence, 1);
+        SDL_ReleaseGPUFence(context->device, fence);
+    }
+}
+
+static bool benchmark_run_format(BenchmarkContext *context, SDL_GPUGraphicsPipeline *pipeline, BatchVertexFormat format,
+                                 uint32_t quad_count, uint32_t iterations, BenchmarkResult *out_result)
+{
+    BatchRenderer2D renderer = {0};
+    if (!batch_renderer_2d_init(&renderer, context->device, context->upload_queue, format))
+    {
+        return false;
+    }
+    batch_renderer_2d_set_memory_cap(&renderer, UINT64_MAX);
+
+    uint64_t build_ticks = 0;
+    uint64_t frame_ticks = 0;
+    bool success = true;
+
+    for (uint32_t iteration = 0; iteration < iterations; iteration++)
+    {
+        staging_ring_begin_frame(context->upload_queue->staging_ring);
+
+        uint32_t seed = 1;
+        uint64_t build_start = SDL_GetPerformanceCounter();
+
+        batch_renderer_2d_begin(&renderer);
+        for (uint32_t i = 0; i < quad_count; i++)
+        {
+            Vector2f position = { benchmark_random(&seed) * 10.0f - 5.0f, benchmark_random(&seed) * 10.0f - 5.0f };
+            Vector2f size = { 0.02f, 0.02f };
+            Vector4f color = { benchmark_random(&seed), benchmark_random(&seed), benchmark_random(&seed), 1.0f };
+            batch_renderer_2d_add_quad(&renderer, position, size, color);
+        }
+        batch_renderer_2d_end(&renderer);
+
+        build_ticks += SDL_GetPerformanceCounter() - build_start;
+
+        SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(context->device);
+        if (!cmd)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer: %s", SDL_GetError());
+            success = false;
+            break;
+        }
+
+        upload_queue_flush(context->upload_queue, cmd);
+
+        SDL_GPUColorTargetInfo target_info = {0};
+        target_info.texture = context->target;
+        target_info.load_op = SDL_GPU_LOADOP_CLEAR;
+        target_info.store_op = SDL_GPU_STOREOP_STORE;
+
+        SDL_GPURenderPass *render_pass = SDL_BeginGPURenderPass(cmd, &target_info, 1, NULL);
+        if (render_pass)
+        {
+            SDL_BindGPUGraphicsPipeline(render_pass, pipeline);
+            SDL_BindGPUVertexStorageBuffers(render_pass, 0, &context->view_projection, 1);
+            batch_renderer_2d_draw(&renderer, render_pass);
+            SDL_EndGPURenderPass(render_pass);
+        }
+
+        uint64_t frame_start = SDL_GetPerformanceCounter();
+        SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+        if (!fence)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit benchmark frame: %s", SDL_GetError());
+            success = false;
+            break;
+        }
+
+        SDL_WaitForGPUFences(context->device, true, &fence, 1);
+        frame_ticks += SDL_GetPerformanceCounter() - frame_start;
+
+        // The ring owns the fence from here and releases it when the slot comes around again
+        staging_ring_end_frame(context->upload_queue->staging_ring, fence);
+    }
+
+    out_result->build_ms = benchmark_elapsed_ms(0, build_ticks) / iterations;
+    out_result->frame_ms = benchmark_elapsed_ms(0, frame_ticks) / iterations;
+    out_result->upload_bytes = (uint64_t)renderer.quad_count * renderer.instance_size;
+
+    batch_renderer_2d_destroy(&renderer);
+    return success;
+}
+
+void benchmark_batch_formats(BenchmarkContext *context, SDL_GPUGraphicsPipeline *pipelines[BATCH_VERTEX_FORMAT_COUNT],
+                             uint32_t quad_count, uint32_t iterations)
+{
+    if (!context || !context->device || !pipelines || quad_count == 0 || iterations == 0)
+    {
+        return;
+    }
+
+    SDL_Log("Batch format benchmark: %u quads, %u iterations", quad_count, iterations);
+
+    for (uint32_t format = 0; format < BATCH_VERTEX_FORMAT_COUNT; format++)
+    {
+        if (!pipelines[format])
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Skipping %s format, no pipeline", format_names[format]);
+            continue;
+        }
+
+        BenchmarkResult result = {0};
+        if (!benchmark_run_format(context, pipelines[format], (BatchVertexFormat)format, quad_count, iterations, &result))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Benchmark of %s format failed", format_names[format]);
+            continue;
+        }
+
+        SDL_Log("  %-8s %2u bytes/quad, %8.2f MB uploaded, build %7.3f ms, frame %7.3f ms",
+                format_names[format], batch_vertex_format_size((BatchVertexFormat)format),
+                (double)result.upload_bytes / (1024.0 * 1024.0), result.build_ms, result.frame_ms);
+    }
+}
+
+void benchmark_batch_threads(BenchmarkContext *context, uint32_t quad_count, uint32_t max_threads, uint32_t iterations)
+{
+    if (!context || !context->device || quad_count == 0 || iterations == 0)
+    {
+        return;
+    }
+
+    if (max_threads > BENCHMARK_MAX_THREADS)
+    {
+        max_threads = BENCHMARK_MAX_THREADS;
+    }
+
+    BatchRenderer2D renderer = {0};
+    if (!batch_renderer_2d_init(&renderer, context->device, context->upload_queue, BATCH_VERTEX_FORMAT_FULL))
+    {
+        return;
+    }
+    batch_renderer_2d_set_memory_cap(&renderer, UINT64_MAX);
+
+    SDL_Log("Threaded batch build benchmark: %u quads, %u iterations", quad_count, iterations);
+
+    BenchmarkWorkerPool pool;
+    for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+    {
+        if (!benchmark_worker_pool_start(&pool, thread_count))
+        {
+            break;
+        }
+
+        uint64_t build_ticks = 0;
+        for (uint32_t iteration = 0; iteration < iterations; iteration++)
+        {
+            uint64_t build_start = SDL_GetPerformanceCounter();
+            batch_renderer_2d_begin(&renderer);
+
+            // Ranges are reserved here in worker order, which fixes the draw order. Workers
+            // past a short reservation get an empty range
+            uint32_t reserved = 0;
+            bool short_reservation = false;
+            for (uint32_t i = 0; i < pool.thread_count; i++)
+            {
+                BenchmarkWorker *worker = &pool.workers[i];
+                SDL_memset(&worker->range, 0, sizeof(BatchRange));
+                worker->first_quad = reserved;
+                if (short_reservation || reserved == quad_count)
+                {
+                    continue;
+                }
+
+                uint32_t count = (quad_count - reserved) / (pool.thread_count - i);
+                worker->range = batch_renderer_2d_reserve(&renderer, count);
+                reserved += worker->range.count;
+                short_reservation = worker->range.count < count;
+            }
+
+            benchmark_worker_pool_run(&pool);
+
+            batch_renderer_2d_end(&renderer);
+            build_ticks += SDL_GetPerformanceCounter() - build_start;
+
+            benchmark_flush_batch(context);
+        }
+
+        SDL_Log("  %2u threads: build %7.3f ms", pool.thread_count, benchmark_elapsed_ms(0, build_ticks) / iterations);
+        benchmark_worker_pool_stop(&pool);
+    }
+
+    batch_renderer_2d_destroy(&renderer);
+}
+
+// Submits cmd and waits for it, returns the CPU time from submit until the GPU finished
+static bool benchmark_submit_and_wait(BenchmarkContext *context, SDL_GPUCommandBuffer *cmd, uint64_t *out_ticks)
+{
+    uint64_t start = SDL_GetPerformanceCounter();
+    SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+    if (!fence)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit benchmark commands: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_WaitForGPUFences(context->device, true, &fence, 1);
+    if (out_ticks)
+    {
+        *out_ticks += SDL_GetPerformanceCounter() - start;
+    }
+    SDL_ReleaseGPUFence(context->device, fence);
+    return true;
+}
+
+// Downloads the sorted pairs and checks that keys ascend and every value points at its key
+static bool benchmark_verify_sort(BenchmarkContext *context, GpuSorter *sorter, const uint32_t *keys, uint32_t count)
+{
+    SDL_GPUTransferBufferCreateInfo transfer_info = {0};
+    transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+    transfer_info.size = 2 * count * sizeof(uint32_t);
+
+    SDL_GPUTransferBuffer *download_buffer = SDL_CreateGPUTransferBuffer(context->device, &transfer_info);
+    SDL_GPUCommandBuffer *cmd = download_buffer ? SDL_AcquireGPUCommandBuffer(context->device) : NULL;
+    if (!cmd)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to download sorted pairs: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(context->device, download_buffer);
+        return false;
+    }
+
+    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(cmd);
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        SDL_GPUBufferRegion src_region = {0};
+        src_region.buffer = i == 0 ? sorter->keys[0] : sorter->values[0];
+        src_region.size = count * sizeof(uint32_t);
+
+        SDL_GPUTransferBufferLocation dst_location = {0};
+        dst_location.transfer_buffer = download_buffer;
+        dst_location.offset = i * count * sizeof(uint32_t);
+        SDL_DownloadFromGPUBuffer(copy_pass, &src_region, &dst_location);
+    }
+    SDL_EndGPUCopyPass(copy_pass);
+
+    bool sorted = benchmark_submit_and_wait(context, cmd, NULL);
+    const uint32_t *pairs = sorted ? (const uint32_t *)SDL_MapGPUTransferBuffer(context->device, download_buffer, false) : NULL;
+    if (pairs)
+    {
+        const uint32_t *values = pairs + count;
+        for (uint32_t i = 0; i < count && sorted; i++)
+        {
+            sorted = values[i] < count && pairs[i] == keys[values[i]] && (i == 0 || pairs[i - 1] <= pairs[i]);
+        }
+        SDL_UnmapGPUTransferBuffer(context->device, download_buffer);
+    }
+
+    SDL_ReleaseGPUTransferBuffer(context->device, download_buffer);
+    return pairs && sorted;
+}
+
+void benchmark_particle_sort(BenchmarkContext *context, uint32_t iterations)
+{
+    if (!context || !context->device || iterations == 0)
+    {
+        return;
+    }
+
+    static const uint32_t pair_counts[3] = { 100000, 1000000, BENCHMARK_SORT_MAX_PAIRS };
+
+    GpuSorter sorter = {0};
+    if (!gpu_sorter_create(&sorter, context->device, BENCHMARK_SORT_MAX_PAIRS))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sort benchmark skipped, no sorter");
+        return;
+    }
+
+    // Source pairs (random keys, then indices) and the counts are uploaded once, every run
+    // copies its pairs into the sorter before the timed submit
+    uint32_t source_size = 2 * BENCHMARK_SORT_MAX_PAIRS * sizeof(uint32_t);
+    SDL_GPUBufferCreateInfo buffer_info = {0};
+    buffer_info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;
+    buffer_info.size = source_size;
+    SDL_GPUBuffer *source_buffer = SDL_CreateGPUBuffer(context->device, &buffer_info);
+    buffer_info.size = sizeof(pair_counts);
+    SDL_GPUBuffer *count_buffer = SDL_CreateGPUBuffer(context->device, &buffer_info);
+
+    SDL_GPUTransferBufferCreateInfo transfer_info = {0};
+    transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    transfer_info.size = source_size + sizeof(pair_counts);
+    SDL_GPUTransferBuffer *upload_buffer = SDL_CreateGPUTransferBuffer(context->device, &transfer_info);
+
+    uint32_t *keys = (uint32_t *)SDL_malloc(BENCHMARK_SORT_MAX_PAIRS * sizeof(uint32_t));
+    uint32_t *upload = upload_buffer ? (uint32_t *)SDL_MapGPUTransferBuffer(context->device, upload_buffer, false) : NULL;
+    if (!source_buffer || !count_buffer || !keys || !upload)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create sort benchmark data: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(context->device, upload_buffer);
+        SDL_ReleaseGPUBuffer(context->device, source_buffer);
+        SDL_ReleaseGPUBuffer(context->device, count_buffer);
+        SDL_free(keys);
+        gpu_sorter_destroy(&sorter);
+        return;
+    }
+
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < BENCHMARK_SORT_MAX_PAIRS; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        keys[i] = seed ^ (seed >> 16);
+        upload[i] = keys[i];
+        upload[BENCHMARK_SORT_MAX_PAIRS + i] = i;
+    }
+    SDL_memcpy(&upload[2 * BENCHMARK_SORT_MAX_PAIRS], pair_counts, sizeof(pair_counts));
+    SDL_UnmapGPUTransferBuffer(context->device, upload_buffer);
+
+    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(context->device);
+    if (cmd)
+    {
+        SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(cmd);
+
+        SDL_GPUTransferBufferLocation src_location = {0};
+        src_location.transfer_buffer = upload_buffer;
+
+        SDL_GPUBufferRegion dst_region = {0};
+        dst_region.buffer = source_buffer;
+        dst_region.size = source_size;
+        SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, false);
+
+        src_location.offset = source_size;
+        dst_region.buffer = count_buffer;
+        dst_region.size = sizeof(pair_counts);
+        SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, false);
+
+        SDL_EndGPUCopyPass(copy_pass);
+        benchmark_submit_and_wait(context, cmd, NULL);
+    }
+    SDL_ReleaseGPUTransferBuffer(context->device, upload_buffer);
+
+    SDL_Log("Particle sort benchmark: 32-bit keys, %u radix passes, %u iterations", GPU_SORT_PASSES, iterations);
+
+    for (uint32_t run = 0; run < SDL_arraysize(pair_counts) && cmd; run++)
+    {
+        uint32_t count = pair_counts[run];
+        uint64_t sort_ticks = 0;
+        bool success = true;
+
+        for (uint32_t iteration = 0; iteration < iterations && success; iteration++)
+        {
+            // Untimed: restore the unsorted pairs
+            SDL_GPUCommandBuffer *copy_cmd = SDL_AcquireGPUCommandBuffer(context->device);
+            success = copy_cmd != NULL;
+            if (success)
+            {
+                SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(copy_cmd);
+                for (uint32_t i = 0; i < 2; i++)
+                {
+                    SDL_GPUBufferLocation src_location = {0};
+                    src_location.buffer = source_buffer;
+                    src_location.offset = i * BENCHMARK_SORT_MAX_PAIRS * sizeof(uint32_t);
+
+                    SDL_GPUBufferLocation dst_location = {0};
+                    dst_location.buffer = i == 0 ? sorter.keys[0] : sorter.values[0];
+                    SDL_CopyGPUBufferToBuffer(copy_pass, &src_location, &dst_location, count * sizeof(uint32_t), false);
+                }
+                SDL_EndGPUCopyPass(copy_pass);
+                success = benchmark_submit_and_wait(context, copy_cmd, NULL);
+            }
+
+            SDL_GPUCommandBuffer *sort_cmd = success ? SDL_AcquireGPUCommandBuffer(context->device) : NULL;
+            success = sort_cmd && gpu_sorter_sort(&sorter, sort_cmd, count_buffer, run);
+            if (sort_cmd)
+            {
+                success = benchmark_submit_and_wait(context, sort_cmd, &sort_ticks) && success;
+            }
+        }
+
+        if (!success)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sort benchmark of %u pairs failed", count);
+            continue;
+        }
+
+        double sort_ms = benchmark_elapsed_ms(0, sort_ticks) / iterations;
+        SDL_Log("  %8u pairs: sort %7.3f ms, %7.1f Mpairs/s, %s", count, sort_ms, (double)count / (sort_ms * 1000.0),
+                benchmark_verify_sort(context, &sorter, keys, count) ? "sorted" : "NOT SORTED");
+    }
+
+    SDL_ReleaseGPUBuffer(context->device, source_buffer);
+    SDL_ReleaseGPUBuffer(context->device, count_buffer);
+    SDL_free(keys);
+    gpu_sorter_destroy(&sorter);
+}
\ No newline at end of file
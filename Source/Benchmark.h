@@ -0,0 +1,43 @@
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "Buffers.h"
+#include "Renderer.h"
+#include "GpuSort.h"
+
+#define BENCHMARK_DEFAULT_QUADS 1000000
+#define BENCHMARK_DEFAULT_ITERATIONS 60
+#define BENCHMARK_MAX_THREADS 32
+#define BENCHMARK_SORT_MAX_PAIRS 4000000
+
+// Offscreen target and bindings shared by every benchmark run
+typedef struct BenchmarkContext
+{
+    SDL_GPUDevice *device;
+    UploadQueue *upload_queue;
+    SDL_GPUTexture *target;
+    SDL_GPUBuffer *view_projection;
+} BenchmarkContext;
+
+typedef struct BenchmarkResult
+{
+    double build_ms;  // average CPU time to fill the batch
+    double frame_ms;  // average time from submit until the GPU finished upload + draw
+    uint64_t upload_bytes;
+} BenchmarkResult;
+
+// Builds, uploads and draws the same quads once per instance format and logs the timings
+void benchmark_batch_formats(BenchmarkContext *context, SDL_GPUGraphicsPipeline *pipelines[BATCH_VERTEX_FORMAT_COUNT],
+                             uint32_t quad_count, uint32_t iterations);
+
+// Fills one batch from 1, 2, 4 ... up to max_threads workers through reserved ranges
+void benchmark_batch_threads(BenchmarkContext *context, uint32_t quad_count, uint32_t max_threads, uint32_t iterations);
+
+// Times the GPU radix sort of random particle keys at 100k, 1M and 4M pairs and checks the
+// order of the last run against the input
+void benchmark_particle_sort(BenchmarkContext *context, uint32_t iterations);
+
+#endif
\ No newline at end of file
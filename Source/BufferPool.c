@@ -0,0 +1,350 @@
+#include "BufferPool.h"
+
+static uint32_t align_up(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static int32_t buffer_pool_size_class(uint32_t size)
+{
+    uint32_t class_size = BUFFER_POOL_ALIGNMENT;
+    for (int32_t i = 0; i < BUFFER_POOL_SIZE_CLASS_COUNT; i++)
+    {
+        if (size <= class_size)
+        {
+            return i;
+        }
+        class_size <<= 1;
+    }
+    return -1;
+}
+
+static uint32_t buffer_pool_class_size(int32_t size_class)
+{
+    return (uint32_t)BUFFER_POOL_ALIGNMENT << size_class;
+}
+
+static BufferPoolPage *buffer_pool_add_page(BufferPool *pool, uint32_t size, int32_t size_class)
+{
+    if (pool->page_count == BUFFER_POOL_MAX_PAGES)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Buffer pool is out of pages");
+        return NULL;
+    }
+
+    BufferPoolPage *page = &pool->pages[pool->page_count];
+    SDL_memset(page, 0, sizeof(BufferPoolPage));
+    page->size = size;
+    page->size_class = size_class;
+
+    if (size_class >= 0)
+    {
+        uint32_t block_count = size / buffer_pool_class_size(size_class);
+        page->free_blocks = (uint32_t *)SDL_malloc(block_count * sizeof(uint32_t));
+        if (!page->free_blocks)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate buffer pool free list");
+            return NULL;
+        }
+
+        // Hand out low offsets first
+        for (uint32_t i = 0; i < block_count; i++)
+        {
+            page->free_blocks[i] = block_count - 1 - i;
+        }
+        page->free_block_count = block_count;
+    }
+    else
+    {
+        page->free_range_capacity = 16;
+        page->free_ranges = (BufferPoolRange *)SDL_malloc(page->free_range_capacity * sizeof(BufferPoolRange));
+        if (!page->free_ranges)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate buffer pool free ranges");
+            return NULL;
+        }
+
+        page->free_ranges[0].offset = 0;
+        page->free_ranges[0].size = size;
+        page->free_range_count = 1;
+    }
+
+    SDL_GPUBufferCreateInfo buffer_info = {0};
+    buffer_info.usage = pool->usage;
+    buffer_info.size = size;
+
+    page->buffer = SDL_CreateGPUBuffer(pool->device, &buffer_info);
+    if (!page->buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create buffer pool page: %s", SDL_GetError());
+        SDL_free(page->free_blocks);
+        SDL_free(page->free_ranges);
+        return NULL;
+    }
+
+    pool->page_count++;
+    return page;
+}
+
+static bool buffer_pool_insert_range(BufferPoolPage *page, uint32_t index, uint32_t offset, uint32_t size)
+{
+    if (page->free_range_count == page->free_range_capacity)
+    {
+        uint32_t new_capacity = page->free_range_capacity * 2;
+        BufferPoolRange *ranges = (BufferPoolRange *)SDL_realloc(page->free_ranges, new_capacity * sizeof(BufferPoolRange));
+        if (!ranges)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to grow buffer pool free ranges");
+            return false;
+        }
+        page->free_ranges = ranges;
+        page->free_range_capacity = new_capacity;
+    }
+
+    SDL_memmove(&page->free_ranges[index + 1], &page->free_ranges[index],
+                (page->free_range_count - index) * sizeof(BufferPoolRange));
+    page->free_ranges[index].offset = offset;
+    page->free_ranges[index].size = size;
+    page->free_range_count++;
+    return true;
+}
+
+static void buffer_pool_remove_range(BufferPoolPage *page, uint32_t index)
+{
+    SDL_memmove(&page->free_ranges[index], &page->free_ranges[index + 1],
+                (page->free_range_count - index - 1) * sizeof(BufferPoolRange));
+    page->free_range_count--;
+}
+
+bool buffer_pool_create(BufferPool *pool, SDL_GPUDevice *device, SDL_GPUBufferUsageFlags usage)
+{
+    if (!pool || !device)
+    {
+        return false;
+    }
+
+    SDL_memset(pool, 0, sizeof(BufferPool));
+    pool->device = device;
+    pool->usage = usage;
+    return true;
+}
+
+void buffer_pool_destroy(BufferPool *pool)
+{
+    if (!pool || !pool->device)
+    {
+        return;
+    }
+
+    if (pool->allocation_count > 0)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Buffer pool destroyed with %u live allocations", pool->allocation_count);
+    }
+
+    for (uint32_t i = 0; i < pool->page_count; i++)
+    {
+        BufferPoolPage *page = &pool->pages[i];
+        SDL_ReleaseGPUBuffer(pool->device, page->buffer);
+        SDL_free(page->free_blocks);
+        SDL_free(page->free_ranges);
+    }
+
+    SDL_memset(pool, 0, sizeof(BufferPool));
+}
+
+bool buffer_pool_allocate(BufferPool *pool, uint32_t size, BufferAllocation *out_allocation)
+{
+    if (!pool || !pool->device || size == 0 || !out_allocation)
+    {
+        return false;
+    }
+
+    int32_t size_class = buffer_pool_size_class(size);
+    if (size_class >= 0)
+    {
+        BufferPoolPage *page = NULL;
+        for (uint32_t i = 0; i < pool->page_count; i++)
+        {
+            if (pool->pages[i].size_class == size_class && pool->pages[i].free_block_count > 0)
+            {
+                page = &pool->pages[i];
+                break;
+            }
+        }
+
+        if (!page)
+        {
+            page = buffer_pool_add_page(pool, BUFFER_POOL_SMALL_PAGE_SIZE, size_class);
+            if (!page)
+            {
+                return false;
+            }
+        }
+
+        uint32_t block = page->free_blocks[--page->free_block_count];
+        uint32_t class_size = buffer_pool_class_size(size_class);
+
+        out_allocation->buffer = page->buffer;
+        out_allocation->offset = block * class_size;
+        out_allocation->size = size;
+        out_allocation->page = (uint32_t)(page - pool->pages);
+
+        pool->allocated_bytes += class_size;
+        pool->requested_bytes += size;
+        pool->allocation_count++;
+        return true;
+    }
+
+    // Best fit over every large page
+    uint32_t block_size = align_up(size, BUFFER_POOL_ALIGNMENT);
+    BufferPoolPage *best_page = NULL;
+    uint32_t best_index = 0;
+
+    for (uint32_t i = 0; i < pool->page_count; i++)
+    {
+        BufferPoolPage *page = &pool->pages[i];
+        if (page->size_class >= 0)
+        {
+            continue;
+        }
+
+        for (uint32_t r = 0; r < page->free_range_count; r++)
+        {
+            uint32_t range_size = page->free_ranges[r].size;
+            if (range_size >= block_size && (!best_page || range_size < best_page->free_ranges[best_index].size))
+            {
+                best_page = page;
+                best_index = r;
+            }
+        }
+    }
+
+    if (!best_page)
+    {
+        uint32_t page_size = block_size > BUFFER_POOL_LARGE_PAGE_SIZE ? block_size : BUFFER_POOL_LARGE_PAGE_SIZE;
+        best_page = buffer_pool_add_page(pool, page_size, -1);
+        if (!best_page)
+        {
+            return false;
+        }
+        best_index = 0;
+    }
+
+    BufferPoolRange *range = &best_page->free_ranges[best_index];
+    out_allocation->buffer = best_page->buffer;
+    out_allocation->offset = range->offset;
+    out_allocation->size = size;
+    out_allocation->page = (uint32_t)(best_page - pool->pages);
+
+    range->offset += block_size;
+    range->size -= block_size;
+    if (range->size == 0)
+    {
+        buffer_pool_remove_range(best_page, best_index);
+    }
+
+    pool->allocated_bytes += block_size;
+    pool->requested_bytes += size;
+    pool->allocation_count++;
+    return true;
+}
+
+void buffer_pool_free(BufferPool *pool, const BufferAllocation *allocation)
+{
+    if (!pool || !allocation || !allocation->buffer || allocation->page >= pool->page_count)
+    {
+        return;
+    }
+
+    BufferPoolPage *page = &pool->pages[allocation->page];
+    uint32_t block_size = 0;
+
+    if (page->size_class >= 0)
+    {
+        block_size = buffer_pool_class_size(page->size_class);
+        page->free_blocks[page->free_block_count++] = allocation->offset / block_size;
+    }
+    else
+    {
+        block_size = align_up(allocation->size, BUFFER_POOL_ALIGNMENT);
+
+        // Find the insertion point, then merge with the neighbours it touches
+        uint32_t index = 0;
+        while (index < page->free_range_count && page->free_ranges[index].offset < allocation->offset)
+        {
+            index++;
+        }
+
+        bool merge_prev = index > 0 &&
+            page->free_ranges[index - 1].offset + page->free_ranges[index - 1].size == allocation->offset;
+        bool merge_next = index < page->free_range_count &&
+            allocation->offset + block_size == page->free_ranges[index].offset;
+
+        if (merge_prev && merge_next)
+        {
+            page->free_ranges[index - 1].size += block_size + page->free_ranges[index].size;
+            buffer_pool_remove_range(page, index);
+        }
+        else if (merge_prev)
+        {
+            page->free_ranges[index - 1].size += block_size;
+        }
+        else if (merge_next)
+        {
+            page->free_ranges[index].offset = allocation->offset;
+            page->free_ranges[index].size += block_size;
+        }
+        else if (!buffer_pool_insert_range(page, index, allocation->offset, block_size))
+        {
+            return;
+        }
+    }
+
+    pool->allocated_bytes -= block_size;
+    pool->requested_bytes -= allocation->size;
+    pool->allocation_count--;
+}
+
+BufferPoolStats buffer_pool_get_stats(const BufferPool *pool)
+{
+    BufferPoolStats stats = {0};
+    if (!pool)
+    {
+        return stats;
+    }
+
+    stats.page_count = pool->page_count;
+    stats.allocation_count = pool->allocation_count;
+    stats.allocated_bytes = pool->allocated_bytes;
+    stats.requested_bytes = pool->requested_bytes;
+
+    for (uint32_t i = 0; i < pool->page_count; i++)
+    {
+        const BufferPoolPage *page = &pool->pages[i];
+        stats.reserved_bytes += page->size;
+
+        for (uint32_t r = 0; r < page->free_range_count; r++)
+        {
+            stats.free_bytes += page->free_ranges[r].size;
+            if (page->free_ranges[r].size > stats.largest_free_range)
+            {
+                stats.largest_free_range = page->free_ranges[r].size;
+            }
+        }
+    }
+
+    if (stats.reserved_bytes > 0)
+    {
+        stats.utilization = (float)((double)stats.requested_bytes / (double)stats.reserved_bytes);
+    }
+    if (stats.allocated_bytes > 0)
+    {
+        stats.internal_fragmentation = 1.0f - (float)((double)stats.requested_bytes / (double)stats.allocated_bytes);
+    }
+    if (stats.free_bytes > 0)
+    {
+        stats.external_fragmentation = 1.0f - (float)((double)stats.largest_free_range / (double)stats.free_bytes);
+    }
+
+    return stats;
+}
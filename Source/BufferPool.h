@@ -0,0 +1,83 @@
+#ifndef _BUFFER_POOL_H
+#define _BUFFER_POOL_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Every allocation starts on this boundary (covers storage buffer offset alignment)
+#define BUFFER_POOL_ALIGNMENT 256
+
+// Power-of-two size classes from 256 B to 64 KB, larger requests use best-fit pages
+#define BUFFER_POOL_SIZE_CLASS_COUNT 9
+#define BUFFER_POOL_MAX_CLASS_SIZE (BUFFER_POOL_ALIGNMENT << (BUFFER_POOL_SIZE_CLASS_COUNT - 1))
+
+#define BUFFER_POOL_SMALL_PAGE_SIZE (1024 * 1024)
+#define BUFFER_POOL_LARGE_PAGE_SIZE (64 * 1024 * 1024)
+#define BUFFER_POOL_MAX_PAGES 64
+
+typedef struct BufferPoolRange
+{
+    uint32_t offset;
+    uint32_t size;
+} BufferPoolRange;
+
+typedef struct BufferPoolPage
+{
+    SDL_GPUBuffer *buffer;
+    uint32_t size;
+    int32_t size_class; // -1 for best-fit pages
+
+    // Size class pages: stack of free block indices
+    uint32_t *free_blocks;
+    uint32_t free_block_count;
+
+    // Best-fit pages: free ranges sorted by offset
+    BufferPoolRange *free_ranges;
+    uint32_t free_range_count;
+    uint32_t free_range_capacity;
+} BufferPoolPage;
+
+typedef struct BufferPoolStats
+{
+    uint64_t reserved_bytes;      // total size of all pages
+    uint64_t allocated_bytes;     // bytes handed out, including size class rounding
+    uint64_t requested_bytes;     // bytes callers asked for
+    uint64_t free_bytes;          // free bytes in best-fit pages
+    uint64_t largest_free_range;  // largest contiguous free range in best-fit pages
+    uint32_t page_count;
+    uint32_t allocation_count;
+    float utilization;            // requested / reserved
+    float internal_fragmentation; // 1 - requested / allocated
+    float external_fragmentation; // 1 - largest free range / free bytes
+} BufferPoolStats;
+
+// Sub-allocates GPU buffers of a single usage from a few large allocations
+typedef struct BufferPool
+{
+    SDL_GPUDevice *device;
+    SDL_GPUBufferUsageFlags usage;
+    BufferPoolPage pages[BUFFER_POOL_MAX_PAGES];
+    uint32_t page_count;
+    uint64_t allocated_bytes;
+    uint64_t requested_bytes;
+    uint32_t allocation_count;
+} BufferPool;
+
+typedef struct BufferAllocation
+{
+    SDL_GPUBuffer *buffer;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t page;
+} BufferAllocation;
+
+bool buffer_pool_create(BufferPool *pool, SDL_GPUDevice *device, SDL_GPUBufferUsageFlags usage);
+void buffer_pool_destroy(BufferPool *pool);
+bool buffer_pool_allocate(BufferPool *pool, uint32_t size, BufferAllocation *out_allocation);
+
+// The range is reused right away, so the GPU must be done reading it
+void buffer_pool_free(BufferPool *pool, const BufferAllocation *allocation);
+BufferPoolStats buffer_pool_get_stats(const BufferPool *pool);
+
+#endif
@@ -68,10 +68,21 @@ bool upload_to_gpu_buffer(SDL_GPUDevice *device, SDL_GPUBuffer *dst_buffer, cons
     return true;
 }
 
+static void free_pooled_allocation(BufferPool *pool, SDL_GPUBuffer *buffer, uint32_t offset, uint32_t size, uint32_t page)
+{
+    BufferAllocation allocation = {0};
+    allocation.buffer = buffer;
+    allocation.offset = offset;
+    allocation.size = size;
+    allocation.page = page;
+    buffer_pool_free(pool, &allocation);
+}
+
 VertexBuffer vertex_buffer_create(SDL_GPUDevice *device, const void *data, uint32_t data_size, uint32_t num_vertices)
 {
     VertexBuffer vertex_buffer = {0};
     vertex_buffer.num_vertices = num_vertices;
+    vertex_buffer.size = data_size;
 
     SDL_GPUBufferCreateInfo buffer_info = {0};
     buffer_info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
@@ -90,13 +101,46 @@ VertexBuffer vertex_buffer_create(SDL_GPUDevice *device, const void *data, uint3
     return vertex_buffer;
 }
 
+VertexBuffer vertex_buffer_create_pooled(BufferPool *pool, const void *data, uint32_t data_size, uint32_t num_vertices)
+{
+    VertexBuffer vertex_buffer = {0};
+
+    BufferAllocation allocation = {0};
+    if (!pool || !buffer_pool_allocate(pool, data_size, &allocation))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate pooled vertex buffer");
+        return vertex_buffer;
+    }
+
+    vertex_buffer.buffer = allocation.buffer;
+    vertex_buffer.offset = allocation.offset;
+    vertex_buffer.size = data_size;
+    vertex_buffer.num_vertices = num_vertices;
+    vertex_buffer.pool = pool;
+    vertex_buffer.pool_page = allocation.page;
+
+    if (data && !upload_to_gpu_buffer(pool->device, allocation.buffer, data, data_size, allocation.offset))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload vertex buffer data");
+    }
+
+    return vertex_buffer;
+}
+
 void vertex_buffer_destroy(SDL_GPUDevice *device, VertexBuffer *vertex_buffer)
 {
     if (vertex_buffer && vertex_buffer->buffer)
     {
-        SDL_ReleaseGPUBuffer(device, vertex_buffer->buffer);
-        vertex_buffer->buffer = NULL;
-        vertex_buffer->num_vertices = 0;
+        if (vertex_buffer->pool)
+        {
+            free_pooled_allocation(vertex_buffer->pool, vertex_buffer->buffer, vertex_buffer->offset,
+                                vertex_buffer->size, vertex_buffer->pool_page);
+        }
+        else
+        {
+            SDL_ReleaseGPUBuffer(device, vertex_buffer->buffer);
+        }
+        SDL_memset(vertex_buffer, 0, sizeof(VertexBuffer));
     }
 }
 
@@ -104,6 +148,7 @@ IndexBuffer index_buffer_create(SDL_GPUDevice *device, const void *data, uint32_
 {
     IndexBuffer index_buffer = {0};
     index_buffer.num_indices = num_indices;
+    index_buffer.size = data_size;
 
     SDL_GPUBufferCreateInfo buffer_info = {0};
     buffer_info.usage = SDL_GPU_BUFFERUSAGE_INDEX;
@@ -122,13 +167,46 @@ IndexBuffer index_buffer_create(SDL_GPUDevice *device, const void *data, uint32_
     return index_buffer;
 }
 
+IndexBuffer index_buffer_create_pooled(BufferPool *pool, const void *data, uint32_t data_size, uint32_t num_indices)
+{
+    IndexBuffer index_buffer = {0};
+
+    BufferAllocation allocation = {0};
+    if (!pool || !buffer_pool_allocate(pool, data_size, &allocation))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate pooled index buffer");
+        return index_buffer;
+    }
+
+    index_buffer.buffer = allocation.buffer;
+    index_buffer.offset = allocation.offset;
+    index_buffer.size = data_size;
+    index_buffer.num_indices = num_indices;
+    index_buffer.pool = pool;
+    index_buffer.pool_page = allocation.page;
+
+    if (data && !upload_to_gpu_buffer(pool->device, allocation.buffer, data, data_size, allocation.offset))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload index buffer data");
+    }
+
+    return index_buffer;
+}
+
 void index_buffer_destroy(SDL_GPUDevice *device, IndexBuffer *index_buffer)
 {
     if (index_buffer && index_buffer->buffer)
     {
-        SDL_ReleaseGPUBuffer(device, index_buffer->buffer);
-        index_buffer->buffer = NULL;
-        index_buffer->num_indices = 0;
+        if (index_buffer->pool)
+        {
+            free_pooled_allocation(index_buffer->pool, index_buffer->buffer, index_buffer->offset,
+                                index_buffer->size, index_buffer->pool_page);
+        }
+        else
+        {
+            SDL_ReleaseGPUBuffer(device, index_buffer->buffer);
+        }
+        SDL_memset(index_buffer, 0, sizeof(IndexBuffer));
     }
 }
 
@@ -142,26 +220,935 @@ UniformBuffer uniform_buffer_create(SDL_GPUDevice *device, uint32_t size)
     buffer_info.size = size;
 
     uniform_buffer.buffer = SDL_CreateGPUBuffer(device, &buffer_info);
+    if (uniform_buffer.buffer)
+    {
+        shadow_buffer_create(&uniform_buffer.shadow, device, uniform_buffer.buffer, 0, size);
+    }
+    return uniform_buffer;
+}
+
+UniformBuffer uniform_buffer_create_pooled(BufferPool *pool, uint32_t size)
+{
+    UniformBuffer uniform_buffer = {0};
+
+    BufferAllocation allocation = {0};
+    if (!pool || !buffer_pool_allocate(pool, size, &allocation))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate pooled uniform buffer");
+        return uniform_buffer;
+    }
+
+    uniform_buffer.buffer = allocation.buffer;
+    uniform_buffer.offset = allocation.offset;
+    uniform_buffer.size = size;
+    uniform_buffer.pool = pool;
+    uniform_buffer.pool_page = allocation.page;
+    shadow_buffer_create(&uniform_buffer.shadow, pool->device, allocation.buffer, allocation.offset, size);
     return uniform_buffer;
 }
 
-void uniform_buffer_update(SDL_GPUDevice *device, UniformBuffer *uniform_buffer, const void *data, uint32_t size)
+bool uniform_buffer_update(SDL_GPUDevice *device, UniformBuffer *uniform_buffer, const void *data, uint32_t size)
 {
     if (!uniform_buffer || !uniform_buffer->buffer || !data)
-        return;
+        return false;
+
+    if (size > uniform_buffer->size)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Uniform buffer update of %u bytes exceeds its %u bytes", size, uniform_buffer->size);
+        return false;
+    }
 
-    if (!upload_to_gpu_buffer(device, uniform_buffer->buffer, data, size, 0))
+    if (!uniform_buffer->shadow.data)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to update uniform buffer");
+        if (!upload_to_gpu_buffer(device, uniform_buffer->buffer, data, size, uniform_buffer->offset))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to update uniform buffer");
+            return false;
+        }
+        return true;
     }
+
+    // Only the bytes that differ from the last update are uploaded
+    shadow_buffer_write(&uniform_buffer->shadow, 0, data, size);
+    shadow_buffer_flush(&uniform_buffer->shadow, NULL);
+    return true;
 }
 
 void uniform_buffer_destroy(SDL_GPUDevice *device, UniformBuffer *uniform_buffer)
 {
     if (uniform_buffer && uniform_buffer->buffer)
     {
-        SDL_ReleaseGPUBuffer(device, uniform_buffer->buffer);
-        uniform_buffer->buffer = NULL;
-        uniform_buffer->size = 0;
+        shadow_buffer_destroy(&uniform_buffer->shadow);
+        if (uniform_buffer->pool)
+        {
+            free_pooled_allocation(uniform_buffer->pool, uniform_buffer->buffer, uniform_buffer->offset,
+                                uniform_buffer->size, uniform_buffer->pool_page);
+        }
+        else
+        {
+            SDL_ReleaseGPUBuffer(device, uniform_buffer->buffer);
+        }
+        SDL_memset(uniform_buffer, 0, sizeof(UniformBuffer));
+    }
+}
+
+bool staging_ring_create(StagingRing *ring, SDL_GPUDevice *device, uint32_t frame_size)
+{
+    if (!ring || !device || frame_size == 0)
+    {
+        return false;
+    }
+
+    SDL_memset(ring, 0, sizeof(StagingRing));
+    ring->device = device;
+    ring->frame_size = frame_size;
+
+    SDL_GPUTransferBufferCreateInfo transfer_info = {0};
+    transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    transfer_info.size = frame_size;
+
+    for (uint32_t i = 0; i < STAGING_RING_FRAMES; i++)
+    {
+        ring->frames[i].transfer_buffer = SDL_CreateGPUTransferBuffer(device, &transfer_info);
+        if (!ring->frames[i].transfer_buffer)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create staging ring transfer buffer: %s", SDL_GetError());
+            staging_ring_destroy(ring);
+            return false;
+        }
+    }
+
+    SDL_Log("Staging ring created: %u frames x %u bytes", STAGING_RING_FRAMES, frame_size);
+    return true;
+}
+
+void staging_ring_destroy(StagingRing *ring)
+{
+    if (!ring || !ring->device)
+    {
+        return;
+    }
+
+    staging_ring_unmap(ring);
+
+    SDL_Log("Staging ring stats: peak %llu bytes/frame, %u stalls, %u overflows",
+            (unsigned long long)ring->stats.peak_frame_bytes_staged, ring->stats.stalls, ring->stats.overflows);
+
+    for (uint32_t i = 0; i < STAGING_RING_FRAMES; i++)
+    {
+        StagingRingFrame *frame = &ring->frames[i];
+        if (frame->fence)
+        {
+            SDL_WaitForGPUFences(ring->device, true, &frame->fence, 1);
+            SDL_ReleaseGPUFence(ring->device, frame->fence);
+            frame->fence = NULL;
+        }
+
+        if (frame->transfer_buffer)
+        {
+            SDL_ReleaseGPUTransferBuffer(ring->device, frame->transfer_buffer);
+            frame->transfer_buffer = NULL;
+        }
+    }
+
+    ring->device = NULL;
+    ring->head = 0;
+}
+
+void staging_ring_begin_frame(StagingRing *ring)
+{
+    if (!ring || !ring->device)
+    {
+        return;
+    }
+
+    staging_ring_unmap(ring);
+
+    ring->stats.last_frame_bytes_staged = ring->stats.bytes_staged;
+    if (ring->stats.bytes_staged > ring->stats.peak_frame_bytes_staged)
+    {
+        ring->stats.peak_frame_bytes_staged = ring->stats.bytes_staged;
+    }
+    ring->stats.bytes_staged = 0;
+
+    ring->frame_index = (ring->frame_index + 1) % STAGING_RING_FRAMES;
+    ring->head = 0;
+
+    // The GPU may still be copying out of this frame's transfer buffer
+    StagingRingFrame *frame = &ring->frames[ring->frame_index];
+    if (frame->fence)
+    {
+        if (!SDL_QueryGPUFence(ring->device, frame->fence))
+        {
+            ring->stats.stalls++;
+            SDL_WaitForGPUFences(ring->device, true, &frame->fence, 1);
+        }
+        SDL_ReleaseGPUFence(ring->device, frame->fence);
+        frame->fence = NULL;
+    }
+}
+
+void staging_ring_end_frame(StagingRing *ring, SDL_GPUFence *fence)
+{
+    if (!ring || !ring->device || !fence)
+    {
+        return;
+    }
+
+    // Submissions retire in order, so the latest fence covers every copy made from this frame
+    StagingRingFrame *frame = &ring->frames[ring->frame_index];
+    if (frame->fence)
+    {
+        SDL_ReleaseGPUFence(ring->device, frame->fence);
+    }
+    frame->fence = fence;
+}
+
+void *staging_ring_allocate(StagingRing *ring, uint32_t size, uint32_t *out_offset)
+{
+    if (!ring || !ring->device || size == 0)
+    {
+        return NULL;
+    }
+
+    uint32_t offset = (ring->head + (STAGING_RING_ALIGNMENT - 1)) & ~(uint32_t)(STAGING_RING_ALIGNMENT - 1);
+    if (offset > ring->frame_size || size > ring->frame_size - offset)
+    {
+        ring->stats.overflows++;
+        return NULL;
+    }
+
+    if (!ring->mapped)
+    {
+        // Never cycle: earlier regions of this buffer may already be referenced by a copy
+        ring->mapped = (uint8_t *)SDL_MapGPUTransferBuffer(ring->device, ring->frames[ring->frame_index].transfer_buffer, false);
+        if (!ring->mapped)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map staging ring: %s", SDL_GetError());
+            return NULL;
+        }
+    }
+
+    ring->head = offset + size;
+    ring->stats.bytes_staged += size;
+
+    if (out_offset)
+    {
+        *out_offset = offset;
+    }
+    return ring->mapped + offset;
+}
+
+SDL_GPUTransferBuffer *staging_ring_unmap(StagingRing *ring)
+{
+    if (!ring || !ring->device)
+    {
+        return NULL;
+    }
+
+    SDL_GPUTransferBuffer *transfer_buffer = ring->frames[ring->frame_index].transfer_buffer;
+    if (ring->mapped)
+    {
+        SDL_UnmapGPUTransferBuffer(ring->device, transfer_buffer);
+        ring->mapped = NULL;
+    }
+    return transfer_buffer;
+}
+
+bool staging_ring_upload(StagingRing *ring, SDL_GPUBuffer *dst_buffer, const void *data, uint32_t size, uint32_t offset)
+{
+    if (!ring || !ring->device || !dst_buffer || !data || size == 0)
+    {
+        return false;
+    }
+
+    uint32_t src_offset = 0;
+    void *staging = staging_ring_allocate(ring, size, &src_offset);
+    if (!staging)
+    {
+        return upload_to_gpu_buffer(ring->device, dst_buffer, data, size, offset);
+    }
+
+    SDL_memcpy(staging, data, size);
+    SDL_GPUTransferBuffer *transfer_buffer = staging_ring_unmap(ring);
+
+    SDL_GPUCommandBuffer *upload_cmd = SDL_AcquireGPUCommandBuffer(ring->device);
+    if (!upload_cmd)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(upload_cmd);
+    if (!copy_pass)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin copy pass: %s", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(upload_cmd);
+        return false;
+    }
+
+    SDL_GPUTransferBufferLocation src_location = {0};
+    src_location.transfer_buffer = transfer_buffer;
+    src_location.offset = src_offset;
+
+    SDL_GPUBufferRegion dst_region = {0};
+    dst_region.buffer = dst_buffer;
+    dst_region.offset = offset;
+    dst_region.size = size;
+
+    SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, false);
+    SDL_EndGPUCopyPass(copy_pass);
+
+    SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(upload_cmd);
+    if (!fence)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit command buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    staging_ring_end_frame(ring, fence);
+    return true;
+}
+
+bool upload_queue_create(UploadQueue *queue, StagingRing *staging_ring, uint32_t initial_capacity)
+{
+    if (!queue || !staging_ring)
+    {
+        return false;
+    }
+
+    SDL_memset(queue, 0, sizeof(UploadQueue));
+    queue->staging_ring = staging_ring;
+    queue->record_capacity = initial_capacity > 0 ? initial_capacity : 16;
+    queue->records = (UploadRecord *)SDL_malloc(queue->record_capacity * sizeof(UploadRecord));
+    if (!queue->records)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate upload queue records");
+        return false;
+    }
+
+    return true;
+}
+
+void upload_queue_destroy(UploadQueue *queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    if (queue->records)
+    {
+        SDL_free(queue->records);
+        queue->records = NULL;
+    }
+
+    queue->staging_ring = NULL;
+    queue->record_count = 0;
+    queue->record_capacity = 0;
+}
+
+static bool upload_queue_push(UploadQueue *queue, SDL_GPUTransferBuffer *transfer_buffer, uint32_t src_offset,
+                              SDL_GPUBuffer *dst_buffer, uint32_t offset, uint32_t size)
+{
+    // Coalesce with the previous record when both sides are contiguous
+    if (queue->record_count > 0)
+    {
+        UploadRecord *last = &queue->records[queue->record_count - 1];
+        if (last->transfer_buffer == transfer_buffer &&
+            last->dst_buffer == dst_buffer &&
+            last->dst_offset + last->size == offset &&
+            last->src_offset + last->size == src_offset)
+        {
+            last->size += size;
+            return true;
+        }
+    }
+
+    if (queue->record_count == queue->record_capacity)
+    {
+        uint32_t new_capacity = queue->record_capacity * 2;
+        UploadRecord *records = (UploadRecord *)SDL_realloc(queue->records, new_capacity * sizeof(UploadRecord));
+        if (!records)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to grow upload queue");
+            return false;
+        }
+        queue->records = records;
+        queue->record_capacity = new_capacity;
+    }
+
+    UploadRecord *record = &queue->records[queue->record_count++];
+    record->transfer_buffer = transfer_buffer;
+    record->dst_buffer = dst_buffer;
+    record->dst_offset = offset;
+    record->src_offset = src_offset;
+    record->size = size;
+    return true;
+}
+
+bool upload_queue_enqueue(UploadQueue *queue, SDL_GPUBuffer *dst_buffer, const void *data, uint32_t size, uint32_t offset)
+{
+    if (!queue || !queue->records || !dst_buffer || !data || size == 0)
+    {
+        return false;
+    }
+
+    uint32_t src_offset = 0;
+    void *staging = staging_ring_allocate(queue->staging_ring, size, &src_offset);
+    if (!staging)
+    {
+        // Keep ordering with what is already queued before going around the ring
+        upload_queue_submit(queue);
+        return upload_to_gpu_buffer(queue->staging_ring->device, dst_buffer, data, size, offset);
+    }
+
+    SDL_memcpy(staging, data, size);
+    return upload_queue_push(queue, NULL, src_offset, dst_buffer, offset, size);
+}
+
+bool upload_queue_enqueue_transfer(UploadQueue *queue, SDL_GPUTransferBuffer *transfer_buffer, uint32_t src_offset,
+                                   SDL_GPUBuffer *dst_buffer, uint32_t offset, uint32_t size)
+{
+    if (!queue || !queue->records || !transfer_buffer || !dst_buffer || size == 0)
+    {
+        return false;
+    }
+
+    return upload_queue_push(queue, transfer_buffer, src_offset, dst_buffer, offset, size);
+}
+
+void upload_queue_flush(UploadQueue *queue, SDL_GPUCommandBuffer *cmd)
+{
+    if (!queue || !cmd || queue->record_count == 0)
+    {
+        return;
+    }
+
+    SDL_GPUTransferBuffer *ring_buffer = staging_ring_unmap(queue->staging_ring);
+
+    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(cmd);
+    if (!copy_pass)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin copy pass: %s", SDL_GetError());
+        return;
     }
-}
\ No newline at end of file
+
+    for (uint32_t i = 0; i < queue->record_count; i++)
+    {
+        UploadRecord *record = &queue->records[i];
+
+        SDL_GPUTransferBufferLocation src_location = {0};
+        src_location.transfer_buffer = record->transfer_buffer ? record->transfer_buffer : ring_buffer;
+        src_location.offset = record->src_offset;
+
+        SDL_GPUBufferRegion dst_region = {0};
+        dst_region.buffer = record->dst_buffer;
+        dst_region.offset = record->dst_offset;
+        dst_region.size = record->size;
+
+        SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, false);
+    }
+
+    SDL_EndGPUCopyPass(copy_pass);
+    queue->record_count = 0;
+}
+
+bool upload_queue_submit(UploadQueue *queue)
+{
+    if (!queue || !queue->staging_ring)
+    {
+        return false;
+    }
+
+    if (queue->record_count == 0)
+    {
+        return true;
+    }
+
+    SDL_GPUCommandBuffer *upload_cmd = SDL_AcquireGPUCommandBuffer(queue->staging_ring->device);
+    if (!upload_cmd)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    upload_queue_flush(queue, upload_cmd);
+
+    SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(upload_cmd);
+    if (!fence)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit command buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    staging_ring_end_frame(queue->staging_ring, fence);
+    return true;
+}
+
+bool readback_ring_create(ReadbackRing *ring, SDL_GPUDevice *device, uint32_t capacity, uint32_t frame_count)
+{
+    if (!ring || !device || capacity == 0 || frame_count < 2 || frame_count > READBACK_RING_MAX_FRAMES)
+    {
+        return false;
+    }
+
+    SDL_memset(ring, 0, sizeof(ReadbackRing));
+    ring->device = device;
+    ring->capacity = capacity;
+    ring->frame_count = frame_count;
+
+    ring->data = (uint8_t *)SDL_malloc(capacity);
+    if (!ring->data)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate readback copy");
+        return false;
+    }
+
+    SDL_GPUTransferBufferCreateInfo transfer_info = {0};
+    transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+    transfer_info.size = capacity;
+
+    for (uint32_t i = 0; i < frame_count; i++)
+    {
+        ring->frames[i].transfer_buffer = SDL_CreateGPUTransferBuffer(device, &transfer_info);
+        if (!ring->frames[i].transfer_buffer)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create readback transfer buffer: %s", SDL_GetError());
+            readback_ring_destroy(ring);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void readback_ring_destroy(ReadbackRing *ring)
+{
+    if (!ring || !ring->device)
+    {
+        return;
+    }
+
+    if (ring->skipped > 0)
+    {
+        SDL_Log("Readback ring stats: %llu requests, %u skipped", (unsigned long long)ring->frame, ring->skipped);
+    }
+
+    for (uint32_t i = 0; i < ring->frame_count; i++)
+    {
+        ReadbackRingFrame *frame = &ring->frames[i];
+        if (frame->fence)
+        {
+            SDL_WaitForGPUFences(ring->device, true, &frame->fence, 1);
+            SDL_ReleaseGPUFence(ring->device, frame->fence);
+        }
+
+        if (frame->transfer_buffer)
+        {
+            SDL_ReleaseGPUTransferBuffer(ring->device, frame->transfer_buffer);
+        }
+    }
+
+    SDL_free(ring->data);
+    SDL_memset(ring, 0, sizeof(ReadbackRing));
+}
+
+bool readback_ring_request(ReadbackRing *ring, SDL_GPUBuffer *buffer, uint32_t offset, uint32_t size)
+{
+    if (!ring || !ring->device || !buffer || size == 0 || size > ring->capacity)
+    {
+        return false;
+    }
+
+    // Frees this request's transfer buffer if its last copy is done
+    readback_ring_poll(ring);
+
+    ring->frame++;
+    ReadbackRingFrame *frame = &ring->frames[ring->frame_index];
+    if (frame->fence)
+    {
+        ring->skipped++;
+        return false;
+    }
+
+    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(ring->device);
+    if (!cmd)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(cmd);
+    if (!copy_pass)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin readback copy pass: %s", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(cmd);
+        ring->skipped++;
+        return false;
+    }
+
+    SDL_GPUBufferRegion src_region = {0};
+    src_region.buffer = buffer;
+    src_region.offset = offset;
+    src_region.size = size;
+
+    SDL_GPUTransferBufferLocation dst_location = {0};
+    dst_location.transfer_buffer = frame->transfer_buffer;
+    dst_location.offset = 0;
+
+    SDL_DownloadFromGPUBuffer(copy_pass, &src_region, &dst_location);
+    SDL_EndGPUCopyPass(copy_pass);
+
+    frame->fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+    if (!frame->fence)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit readback: %s", SDL_GetError());
+        return false;
+    }
+
+    frame->frame = ring->frame;
+    frame->size = size;
+    ring->frame_index = (ring->frame_index + 1) % ring->frame_count;
+    return true;
+}
+
+bool readback_ring_poll(ReadbackRing *ring)
+{
+    if (!ring || !ring->device)
+    {
+        return false;
+    }
+
+    // Only the newest finished copy is worth mapping, older ones are just retired
+    ReadbackRingFrame *newest = NULL;
+    for (uint32_t i = 0; i < ring->frame_count; i++)
+    {
+        ReadbackRingFrame *frame = &ring->frames[i];
+        if (!frame->fence || !SDL_QueryGPUFence(ring->device, frame->fence))
+        {
+            continue;
+        }
+
+        SDL_ReleaseGPUFence(ring->device, frame->fence);
+        frame->fence = NULL;
+
+        if (frame->frame > ring->data_frame && (!newest || frame->frame > newest->frame))
+        {
+            newest = frame;
+        }
+    }
+
+    if (!newest)
+    {
+        return false;
+    }
+
+    // The copy has retired, so mapping without cycling cannot stall
+    void *mapped_data = SDL_MapGPUTransferBuffer(ring->device, newest->transfer_buffer, false);
+    if (!mapped_data)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map readback buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_memcpy(ring->data, mapped_data, newest->size);
+    SDL_UnmapGPUTransferBuffer(ring->device, newest->transfer_buffer);
+
+    ring->data_size = newest->size;
+    ring->data_frame = newest->frame;
+    return true;
+}
+
+uint64_t readback_ring_latency(const ReadbackRing *ring)
+{
+    if (!ring || ring->data_frame == 0)
+    {
+        return UINT64_MAX;
+    }
+
+    return ring->frame - ring->data_frame;
+}
+
+static void shadow_buffer_merge_closest(ShadowBuffer *shadow)
+{
+    uint32_t best = 0;
+    uint32_t best_gap = UINT32_MAX;
+    for (uint32_t i = 0; i + 1 < shadow->range_count; i++)
+    {
+        uint32_t gap = shadow->ranges[i + 1].begin - shadow->ranges[i].end;
+        if (gap < best_gap)
+        {
+            best_gap = gap;
+            best = i;
+        }
+    }
+
+    shadow->ranges[best].end = shadow->ranges[best + 1].end;
+    SDL_memmove(&shadow->ranges[best + 1], &shadow->ranges[best + 2],
+                (shadow->range_count - best - 2) * sizeof(DirtyRange));
+    shadow->range_count--;
+}
+
+static void shadow_buffer_add_range(ShadowBuffer *shadow, uint32_t begin, uint32_t end)
+{
+    // Search from the back, sequential writes almost always land on the last range
+    uint32_t index = shadow->range_count;
+    while (index > 0 && shadow->ranges[index - 1].begin > begin)
+    {
+        index--;
+    }
+
+    if (index > 0 && shadow->ranges[index - 1].end + SHADOW_BUFFER_MERGE_GAP >= begin)
+    {
+        index--;
+        if (end > shadow->ranges[index].end)
+        {
+            shadow->ranges[index].end = end;
+        }
+    }
+    else
+    {
+        SDL_memmove(&shadow->ranges[index + 1], &shadow->ranges[index],
+                    (shadow->range_count - index) * sizeof(DirtyRange));
+        shadow->ranges[index].begin = begin;
+        shadow->ranges[index].end = end;
+        shadow->range_count++;
+    }
+
+    // Absorb following ranges that now touch this one
+    DirtyRange *range = &shadow->ranges[index];
+    uint32_t next = index + 1;
+    while (next < shadow->range_count && shadow->ranges[next].begin <= range->end + SHADOW_BUFFER_MERGE_GAP)
+    {
+        if (shadow->ranges[next].end > range->end)
+        {
+            range->end = shadow->ranges[next].end;
+        }
+        next++;
+    }
+
+    if (next > index + 1)
+    {
+        SDL_memmove(&shadow->ranges[index + 1], &shadow->ranges[next],
+                    (shadow->range_count - next) * sizeof(DirtyRange));
+        shadow->range_count -= next - (index + 1);
+    }
+
+    if (shadow->range_count > SHADOW_BUFFER_MAX_RANGES)
+    {
+        shadow_buffer_merge_closest(shadow);
+    }
+}
+
+bool shadow_buffer_create(ShadowBuffer *shadow, SDL_GPUDevice *device, SDL_GPUBuffer *buffer, uint32_t offset, uint32_t size)
+{
+    if (!shadow || !device || !buffer || size == 0)
+    {
+        return false;
+    }
+
+    SDL_memset(shadow, 0, sizeof(ShadowBuffer));
+    shadow->device = device;
+    shadow->buffer = buffer;
+    shadow->offset = offset;
+    shadow->size = size;
+
+    shadow->data = (uint8_t *)SDL_calloc(1, size);
+    // One spare slot so an insert can happen before merging back down to the limit
+    shadow->ranges = (DirtyRange *)SDL_malloc((SHADOW_BUFFER_MAX_RANGES + 1) * sizeof(DirtyRange));
+    if (!shadow->data || !shadow->ranges)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate shadow buffer");
+        shadow_buffer_destroy(shadow);
+        return false;
+    }
+
+    return true;
+}
+
+void shadow_buffer_destroy(ShadowBuffer *shadow)
+{
+    if (!shadow)
+    {
+        return;
+    }
+
+    SDL_free(shadow->data);
+    SDL_free(shadow->ranges);
+    SDL_memset(shadow, 0, sizeof(ShadowBuffer));
+}
+
+void shadow_buffer_write(ShadowBuffer *shadow, uint32_t offset, const void *data, uint32_t size)
+{
+    if (!shadow || !shadow->data || !data || size == 0 || offset > shadow->size || size > shadow->size - offset)
+    {
+        return;
+    }
+
+    const uint8_t *src = (const uint8_t *)data;
+    uint8_t *dst = shadow->data + offset;
+    shadow->bytes_written += size;
+
+    // The GPU copy of never-written bytes is undefined, so they cannot be compared. A write past
+    // synced_end also uploads the gap before it (zeros in the shadow), so every byte below the
+    // new synced_end matches the GPU
+    if (offset + size > shadow->synced_end)
+    {
+        uint32_t begin = offset < shadow->synced_end ? offset : shadow->synced_end;
+        SDL_memcpy(dst, src, size);
+        shadow_buffer_add_range(shadow, begin, offset + size);
+        shadow->synced_end = offset + size;
+        return;
+    }
+
+    if (SDL_memcmp(dst, src, size) == 0)
+    {
+        return;
+    }
+
+    // Narrow down to the span that actually changed
+    uint32_t first = 0;
+    while (dst[first] == src[first])
+    {
+        first++;
+    }
+
+    uint32_t last = size;
+    while (dst[last - 1] == src[last - 1])
+    {
+        last--;
+    }
+
+    SDL_memcpy(dst + first, src + first, last - first);
+    shadow_buffer_add_range(shadow, offset + first, offset + last);
+}
+
+void shadow_buffer_mark_dirty(ShadowBuffer *shadow, uint32_t offset, uint32_t size)
+{
+    if (!shadow || !shadow->data || size == 0 || offset > shadow->size || size > shadow->size - offset)
+    {
+        return;
+    }
+
+    shadow_buffer_add_range(shadow, offset, offset + size);
+}
+
+// Packs every dirty range into one transfer buffer and copies them in one copy pass and submit
+static bool shadow_buffer_upload_ranges(ShadowBuffer *shadow)
+{
+    uint32_t total_size = 0;
+    for (uint32_t i = 0; i < shadow->range_count; i++)
+    {
+        total_size += shadow->ranges[i].end - shadow->ranges[i].begin;
+    }
+
+    SDL_GPUTransferBufferCreateInfo transfer_info = {0};
+    transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    transfer_info.size = total_size;
+
+    SDL_GPUTransferBuffer *transfer_buffer = SDL_CreateGPUTransferBuffer(shadow->device, &transfer_info);
+    if (!transfer_buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create transfer buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    uint8_t *mapped_data = (uint8_t *)SDL_MapGPUTransferBuffer(shadow->device, transfer_buffer, false);
+    if (!mapped_data)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map transfer buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(shadow->device, transfer_buffer);
+        return false;
+    }
+
+    uint32_t packed_offset = 0;
+    for (uint32_t i = 0; i < shadow->range_count; i++)
+    {
+        DirtyRange *range = &shadow->ranges[i];
+        SDL_memcpy(mapped_data + packed_offset, shadow->data + range->begin, range->end - range->begin);
+        packed_offset += range->end - range->begin;
+    }
+    SDL_UnmapGPUTransferBuffer(shadow->device, transfer_buffer);
+
+    SDL_GPUCommandBuffer *upload_cmd = SDL_AcquireGPUCommandBuffer(shadow->device);
+    if (!upload_cmd)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer: %s", SDL_GetError());
+        SDL_ReleaseGPUTransferBuffer(shadow->device, transfer_buffer);
+        return false;
+    }
+
+    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(upload_cmd);
+    if (!copy_pass)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin copy pass: %s", SDL_GetError());
+        SDL_CancelGPUCommandBuffer(upload_cmd);
+        SDL_ReleaseGPUTransferBuffer(shadow->device, transfer_buffer);
+        return false;
+    }
+
+    packed_offset = 0;
+    for (uint32_t i = 0; i < shadow->range_count; i++)
+    {
+        DirtyRange *range = &shadow->ranges[i];
+
+        SDL_GPUTransferBufferLocation src_location = {0};
+        src_location.transfer_buffer = transfer_buffer;
+        src_location.offset = packed_offset;
+
+        SDL_GPUBufferRegion dst_region = {0};
+        dst_region.buffer = shadow->buffer;
+        dst_region.offset = shadow->offset + range->begin;
+        dst_region.size = range->end - range->begin;
+
+        SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, false);
+        packed_offset += dst_region.size;
+    }
+    SDL_EndGPUCopyPass(copy_pass);
+
+    bool submitted = SDL_SubmitGPUCommandBuffer(upload_cmd);
+    if (!submitted)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit command buffer: %s", SDL_GetError());
+    }
+    SDL_ReleaseGPUTransferBuffer(shadow->device, transfer_buffer);
+    return submitted;
+}
+
+void shadow_buffer_flush(ShadowBuffer *shadow, UploadQueue *queue)
+{
+    if (!shadow || !shadow->data || shadow->range_count == 0)
+    {
+        return;
+    }
+
+    if (!queue)
+    {
+        if (!shadow_buffer_upload_ranges(shadow))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload shadow buffer ranges");
+            return;
+        }
+
+        for (uint32_t i = 0; i < shadow->range_count; i++)
+        {
+            shadow->bytes_uploaded += shadow->ranges[i].end - shadow->ranges[i].begin;
+        }
+        shadow->range_count = 0;
+        return;
+    }
+
+    for (uint32_t i = 0; i < shadow->range_count; i++)
+    {
+        DirtyRange *range = &shadow->ranges[i];
+        uint32_t size = range->end - range->begin;
+        if (!upload_queue_enqueue(queue, shadow->buffer, shadow->data + range->begin, size, shadow->offset + range->begin))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload shadow buffer range");
+        }
+        shadow->bytes_uploaded += size;
+    }
+
+    shadow->range_count = 0;
+}
@@ -3,39 +3,226 @@
 
 #include <SDL3/SDL.h>
 #include <stdint.h>
+#include "BufferPool.h"
 
+// Ranges closer than this are merged, a few redundant bytes are cheaper than another copy
+#define SHADOW_BUFFER_MERGE_GAP 64
+#define SHADOW_BUFFER_MAX_RANGES 1024
+
+typedef struct DirtyRange
+{
+    uint32_t begin;
+    uint32_t end;
+} DirtyRange;
+
+// CPU copy of a GPU buffer region that tracks which bytes changed since the last flush
+typedef struct ShadowBuffer
+{
+    SDL_GPUDevice *device;
+    SDL_GPUBuffer *buffer;
+    uint32_t offset;
+    uint32_t size;
+    uint8_t *data;
+    uint32_t synced_end; // bytes past this were never written and always count as changed
+
+    DirtyRange *ranges; // sorted by begin, never overlapping
+    uint32_t range_count;
+
+    uint64_t bytes_written;
+    uint64_t bytes_uploaded;
+} ShadowBuffer;
+
+// Buffer handles address (buffer, offset, size). Pooled handles share their
+// buffer with other allocations, dedicated ones have pool == NULL and offset 0.
 typedef struct VertexBuffer
 {
     SDL_GPUBuffer *buffer;
+    uint32_t offset;
+    uint32_t size;
     uint32_t num_vertices;
+    BufferPool *pool;
+    uint32_t pool_page;
 } VertexBuffer;
 
 typedef struct IndexBuffer
 {
     SDL_GPUBuffer *buffer;
+    uint32_t offset;
+    uint32_t size;
     uint32_t num_indices;
+    BufferPool *pool;
+    uint32_t pool_page;
 } IndexBuffer;
 
 typedef struct UniformBuffer
 {
     SDL_GPUBuffer *buffer;
+    uint32_t offset;
     uint32_t size;
+    BufferPool *pool;
+    uint32_t pool_page;
+    ShadowBuffer shadow;
 } UniformBuffer;
 
+// Readback rings keep between 2 and this many downloads in flight
+#define READBACK_RING_MAX_FRAMES 4
+#define READBACK_RING_DEFAULT_FRAMES 3
+
+typedef struct ReadbackRingFrame
+{
+    SDL_GPUTransferBuffer *transfer_buffer;
+    SDL_GPUFence *fence; // NULL once the copy has been collected
+    uint64_t frame;      // request number the copy was made for
+    uint32_t size;
+} ReadbackRingFrame;
+
+// Downloads a GPU buffer into one of N persistent transfer buffers per request and hands
+// back the newest copy the GPU has finished, so the CPU sees data N-1 requests old at worst
+// and never waits on the GPU
+typedef struct ReadbackRing
+{
+    SDL_GPUDevice *device;
+    ReadbackRingFrame frames[READBACK_RING_MAX_FRAMES];
+    uint32_t frame_count;
+    uint32_t frame_index;
+    uint32_t capacity;
+    uint64_t frame; // requests made so far
+
+    // Newest collected copy, data_frame is 0 until the first one lands
+    uint8_t *data;
+    uint32_t data_size;
+    uint64_t data_frame;
+
+    uint32_t skipped; // requests dropped because their transfer buffer was still in flight or the copy failed to record
+} ReadbackRing;
+
+// Number of frames the staging ring can have in flight at once
+#define STAGING_RING_FRAMES 3
+#define STAGING_RING_DEFAULT_FRAME_SIZE (8 * 1024 * 1024)
+#define STAGING_RING_ALIGNMENT 16
+
+typedef struct StagingRingStats
+{
+    uint64_t bytes_staged;            // bytes staged so far in the current frame
+    uint64_t last_frame_bytes_staged; // bytes staged in the previous frame
+    uint64_t peak_frame_bytes_staged; // largest per-frame total seen
+    uint32_t stalls;                  // times begin_frame had to wait on the GPU
+    uint32_t overflows;               // allocations that did not fit in a frame
+} StagingRingStats;
+
+typedef struct StagingRingFrame
+{
+    SDL_GPUTransferBuffer *transfer_buffer;
+    SDL_GPUFence *fence;
+} StagingRingFrame;
+
+// Persistent upload staging memory, one transfer buffer per frame in flight.
+// Allocations are linear within the current frame's transfer buffer.
+typedef struct StagingRing
+{
+    SDL_GPUDevice *device;
+    StagingRingFrame frames[STAGING_RING_FRAMES];
+    uint32_t frame_size;
+    uint32_t frame_index;
+    uint32_t head;
+    uint8_t *mapped;
+    StagingRingStats stats;
+} StagingRing;
+
+typedef struct UploadRecord
+{
+    SDL_GPUTransferBuffer *transfer_buffer; // NULL for staging ring memory
+    SDL_GPUBuffer *dst_buffer;
+    uint32_t dst_offset;
+    uint32_t src_offset;
+    uint32_t size;
+} UploadRecord;
+
+// Collects a frame's buffer uploads and records them as a single copy pass
+typedef struct UploadQueue
+{
+    StagingRing *staging_ring;
+    UploadRecord *records;
+    uint32_t record_count;
+    uint32_t record_capacity;
+} UploadQueue;
+
 // Create vertex buffer with data
 VertexBuffer vertex_buffer_create(SDL_GPUDevice *device, const void *data, uint32_t data_size, uint32_t num_vertices);
+VertexBuffer vertex_buffer_create_pooled(BufferPool *pool, const void *data, uint32_t data_size, uint32_t num_vertices);
 void vertex_buffer_destroy(SDL_GPUDevice *device, VertexBuffer *vertex_buffer);
 
 // Create index buffer with data
 IndexBuffer index_buffer_create(SDL_GPUDevice *device, const void *data, uint32_t data_size, uint32_t num_indices);
+IndexBuffer index_buffer_create_pooled(BufferPool *pool, const void *data, uint32_t data_size, uint32_t num_indices);
 void index_buffer_destroy(SDL_GPUDevice *device, IndexBuffer *index_buffer);
 
-// Create uniform buffer
+// Create uniform buffer, pooled blocks have to be addressed by offset in the shader
+// since storage buffer bindings do not take an offset
 UniformBuffer uniform_buffer_create(SDL_GPUDevice *device, uint32_t size);
-void uniform_buffer_update(SDL_GPUDevice *device, UniformBuffer *uniform_buffer, const void *data, uint32_t size);
+UniformBuffer uniform_buffer_create_pooled(BufferPool *pool, uint32_t size);
+bool uniform_buffer_update(SDL_GPUDevice *device, UniformBuffer *uniform_buffer, const void *data, uint32_t size);
 void uniform_buffer_destroy(SDL_GPUDevice *device, UniformBuffer *uniform_buffer);
 
 // Helper function to upload data to GPU buffer
 bool upload_to_gpu_buffer(SDL_GPUDevice *device, SDL_GPUBuffer *dst_buffer, const void *data, uint32_t size, uint32_t offset);
 
+// Staging ring
+bool staging_ring_create(StagingRing *ring, SDL_GPUDevice *device, uint32_t frame_size);
+void staging_ring_destroy(StagingRing *ring);
+void staging_ring_begin_frame(StagingRing *ring);
+void staging_ring_end_frame(StagingRing *ring, SDL_GPUFence *fence);
+
+// Returns a write pointer into the current frame's transfer buffer, or NULL if it is full.
+// The ring must be unmapped with staging_ring_unmap before the copy is recorded.
+void *staging_ring_allocate(StagingRing *ring, uint32_t size, uint32_t *out_offset);
+SDL_GPUTransferBuffer *staging_ring_unmap(StagingRing *ring);
+
+// Upload through the ring, falls back to upload_to_gpu_buffer when the frame is full
+bool staging_ring_upload(StagingRing *ring, SDL_GPUBuffer *dst_buffer, const void *data, uint32_t size, uint32_t offset);
+
+// Upload queue
+bool upload_queue_create(UploadQueue *queue, StagingRing *staging_ring, uint32_t initial_capacity);
+void upload_queue_destroy(UploadQueue *queue);
+
+// Copies data into staging memory now, the GPU copy is recorded by the next flush
+bool upload_queue_enqueue(UploadQueue *queue, SDL_GPUBuffer *dst_buffer, const void *data, uint32_t size, uint32_t offset);
+
+// Queue a copy out of a caller-owned transfer buffer, it must be unmapped before the flush
+bool upload_queue_enqueue_transfer(UploadQueue *queue, SDL_GPUTransferBuffer *transfer_buffer, uint32_t src_offset,
+                                   SDL_GPUBuffer *dst_buffer, uint32_t offset, uint32_t size);
+
+// Record all pending uploads as one copy pass at the current position of cmd
+void upload_queue_flush(UploadQueue *queue, SDL_GPUCommandBuffer *cmd);
+
+// Flush pending uploads in a dedicated command buffer
+bool upload_queue_submit(UploadQueue *queue);
+
+// Readback ring
+bool readback_ring_create(ReadbackRing *ring, SDL_GPUDevice *device, uint32_t capacity, uint32_t frame_count);
+void readback_ring_destroy(ReadbackRing *ring);
+
+// Submits a download of the range in its own command buffer, so call it after the work that
+// writes the buffer has been submitted. Skips the request instead of waiting when its
+// transfer buffer is still busy
+bool readback_ring_request(ReadbackRing *ring, SDL_GPUBuffer *buffer, uint32_t offset, uint32_t size);
+
+// Collects finished downloads without waiting, returns true when ring->data got newer
+bool readback_ring_poll(ReadbackRing *ring);
+
+// Requests between the newest one and the copy in ring->data, UINT64_MAX before the first copy
+uint64_t readback_ring_latency(const ReadbackRing *ring);
+
+// Shadow buffer
+bool shadow_buffer_create(ShadowBuffer *shadow, SDL_GPUDevice *device, SDL_GPUBuffer *buffer, uint32_t offset, uint32_t size);
+void shadow_buffer_destroy(ShadowBuffer *shadow);
+
+// Copies data into the shadow and marks only the bytes that actually changed
+void shadow_buffer_write(ShadowBuffer *shadow, uint32_t offset, const void *data, uint32_t size);
+void shadow_buffer_mark_dirty(ShadowBuffer *shadow, uint32_t offset, uint32_t size);
+
+// Uploads the dirty ranges through the queue. When queue is NULL they are packed into one
+// transfer buffer and copied in one copy pass and submit of their own
+void shadow_buffer_flush(ShadowBuffer *shadow, UploadQueue *queue);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "GpuCulling.h"
+#include "Shader.h"
+#include <stdlib.h>
+
+// Matches CullParams in quad_cull.comp (std140)
+typedef struct GpuCullParams
+{
+    float bounds[4];
+    uint32_t quad_count;
+    uint32_t words_per_quad;
+    uint32_t compact;
+    uint32_t padding;
+} GpuCullParams;
+
+static bool gpu_culler_grow(GpuCuller *culler, uint32_t capacity)
+{
+    SDL_GPUBufferCreateInfo buffer_info = {0};
+    buffer_info.usage = SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+    buffer_info.size = capacity * culler->instance_size;
+
+    SDL_GPUBuffer *visible_buffer = SDL_CreateGPUBuffer(culler->device, &buffer_info);
+    if (!visible_buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create visible quad buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    // Release is deferred by SDL until in-flight draws are done with the old buffer
+    if (culler->visible_buffer)
+    {
+        SDL_ReleaseGPUBuffer(culler->device, culler->visible_buffer);
+    }
+
+    culler->visible_buffer = visible_buffer;
+    culler->capacity = capacity;
+    return true;
+}
+
+bool gpu_culler_create(GpuCuller *culler, SDL_GPUDevice *device, BatchVertexFormat format, uint32_t capacity)
+{
+    if (!culler || !device || capacity == 0 || format >= BATCH_VERTEX_FORMAT_COUNT)
+    {
+        return false;
+    }
+
+    SDL_memset(culler, 0, sizeof(GpuCuller));
+    culler->device = device;
+    culler->format = format;
+    culler->instance_size = batch_vertex_format_size(format);
+
+    if (!gpu_culler_grow(culler, capacity))
+    {
+        gpu_culler_destroy(culler);
+        return false;
+    }
+
+    SDL_GPUBufferCreateInfo indirect_info = {0};
+    indirect_info.usage = SDL_GPU_BUFFERUSAGE_INDIRECT | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+    indirect_info.size = sizeof(SDL_GPUIndirectDrawCommand);
+
+    culler->indirect_buffer = SDL_CreateGPUBuffer(device, &indirect_info);
+    if (!culler->indirect_buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create indirect draw buffer: %s", SDL_GetError());
+        gpu_culler_destroy(culler);
+        return false;
+    }
+
+    // The reset arguments never change, so they are written once and copied every dispatch
+    SDL_GPUTransferBufferCreateInfo reset_info = {0};
+    reset_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    reset_info.size = sizeof(SDL_GPUIndirectDrawCommand);
+
+    culler->reset_buffer = SDL_CreateGPUTransferBuffer(device, &reset_info);
+    if (!culler->reset_buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create indirect reset buffer: %s", SDL_GetError());
+        gpu_culler_destroy(culler);
+        return false;
+    }
+
+    SDL_GPUIndirectDrawCommand *reset_args = (SDL_GPUIndirectDrawCommand *)SDL_MapGPUTransferBuffer(device, culler->reset_buffer, false);
+    if (!reset_args)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map indirect reset buffer: %s", SDL_GetError());
+        gpu_culler_destroy(culler);
+        return false;
+    }
+
+    reset_args->num_vertices = QUAD_INSTANCE_VERTICES;
+    reset_args->num_instances = 0;
+    reset_args->first_vertex = 0;
+    reset_args->first_instance = 0;
+    SDL_UnmapGPUTransferBuffer(device, culler->reset_buffer);
+
+    ShaderBinary compute_binary = shader_load_from_binary("Resources/Shaders/quad_cull.comp.spv");
+    if (!compute_binary.bytes)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load quad cull compute shader");
+        gpu_culler_destroy(culler);
+        return false;
+    }
+
+    SDL_GPUComputePipelineCreateInfo compute_pipeline_info = {0};
+    compute_pipeline_info.code = compute_binary.bytes;
+    compute_pipeline_info.code_size = compute_binary.size;
+    compute_pipeline_info.entrypoint = "main";
+    compute_pipeline_info.format = SDL_GPU_SHADERFORMAT_SPIRV;
+    compute_pipeline_info.num_readonly_storage_buffers = 1;  // source instances
+    compute_pipeline_info.num_readwrite_storage_buffers = 2; // visible instances, draw arguments
+    compute_pipeline_info.num_uniform_buffers = 1;           // cull params
+    compute_pipeline_info.threadcount_x = 64;                // must match shader local_size_x
+    compute_pipeline_info.threadcount_y = 1;
+    compute_pipeline_info.threadcount_z = 1;
+
+    culler->pipeline = SDL_CreateGPUComputePipeline(device, &compute_pipeline_info);
+    free(compute_binary.bytes);
+
+    if (!culler->pipeline)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create quad cull pipeline: %s", SDL_GetError());
+        gpu_culler_destroy(culler);
+        return false;
+    }
+
+    return true;
+}
+
+void gpu_culler_destroy(GpuCuller *culler)
+{
+    if (!culler || !culler->device)
+    {
+        return;
+    }
+
+    if (culler->pipeline)
+    {
+        SDL_ReleaseGPUComputePipeline(culler->device, culler->pipeline);
+    }
+    if (culler->reset_buffer)
+    {
+        SDL_ReleaseGPUTransferBuffer(culler->device, culler->reset_buffer);
+    }
+    if (culler->indirect_buffer)
+    {
+        SDL_ReleaseGPUBuffer(culler->device, culler->indirect_buffer);
+    }
+    if (culler->visible_buffer)
+    {
+        SDL_ReleaseGPUBuffer(culler->device, culler->visible_buffer);
+    }
+
+    SDL_memset(culler, 0, sizeof(GpuCuller));
+}
+
+bool gpu_culler_dispatch(GpuCuller *culler, SDL_GPUCommandBuffer *cmd, SDL_GPUBuffer *source_buffer, uint32_t quad_count, Rect2f bounds)
+{
+    if (!culler || !culler->pipeline)
+    {
+        return false;
+    }
+
+    culler->dispatched = false;
+    if (!cmd || !source_buffer || quad_count == 0)
+    {
+        return false;
+    }
+
+    if (quad_count > culler->capacity)
+    {
+        uint32_t capacity = culler->capacity;
+        while (capacity < quad_count)
+        {
+            capacity *= 2;
+        }
+
+        if (!gpu_culler_grow(culler, capacity))
+        {
+            return false;
+        }
+    }
+
+    // Reset the instance count, cycling so last frame's indirect draw keeps its arguments
+    // Without the reset the append would run past visible_buffer, so nothing is dispatched
+    SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(cmd);
+    if (!copy_pass)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin quad cull reset pass: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_GPUTransferBufferLocation src_location = {0};
+    src_location.transfer_buffer = culler->reset_buffer;
+    src_location.offset = 0;
+
+    SDL_GPUBufferRegion dst_region = {0};
+    dst_region.buffer = culler->indirect_buffer;
+    dst_region.offset = 0;
+    dst_region.size = sizeof(SDL_GPUIndirectDrawCommand);
+
+    SDL_UploadToGPUBuffer(copy_pass, &src_location, &dst_region, true);
+    SDL_EndGPUCopyPass(copy_pass);
+
+    SDL_GPUStorageBufferReadWriteBinding readwrite_bindings[2] = {0};
+    readwrite_bindings[0].buffer = culler->visible_buffer;
+    readwrite_bindings[0].cycle = true;
+    readwrite_bindings[1].buffer = culler->indirect_buffer;
+    readwrite_bindings[1].cycle = false; // would discard the reset above
+
+    SDL_GPUComputePass *compute_pass = SDL_BeginGPUComputePass(cmd, NULL, 0, readwrite_bindings, 2);
+    if (!compute_pass)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin quad cull pass");
+        return false;
+    }
+
+    GpuCullParams params = {0};
+    params.bounds[0] = bounds.min.x;
+    params.bounds[1] = bounds.min.y;
+    params.bounds[2] = bounds.max.x;
+    params.bounds[3] = bounds.max.y;
+    params.quad_count = quad_count;
+    params.words_per_quad = culler->instance_size / sizeof(uint32_t);
+    params.compact = culler->format == BATCH_VERTEX_FORMAT_COMPACT;
+
+    SDL_BindGPUComputePipeline(compute_pass, culler->pipeline);
+    SDL_BindGPUComputeStorageBuffers(compute_pass, 0, &source_buffer, 1);
+    SDL_PushGPUComputeUniformData(cmd, 0, &params, sizeof(params));
+
+    SDL_DispatchGPUCompute(compute_pass, (quad_count + 63) / 64, 1, 1);
+    SDL_EndGPUComputePass(compute_pass);
+
+    culler->dispatched = true;
+    return true;
+}
+
+void gpu_culler_draw(GpuCuller *culler, SDL_GPURenderPass *render_pass)
+{
+    if (!culler || !culler->dispatched || !render_pass)
+    {
+        return;
+    }
+
+    SDL_GPUBufferBinding instance_binding = {0};
+    instance_binding.buffer = culler->visible_buffer;
+    instance_binding.offset = 0;
+    SDL_BindGPUVertexBuffers(render_pass, 0, &instance_binding, 1);
+
+    SDL_DrawGPUPrimitivesIndirect(render_pass, culler->indirect_buffer, 0, 1);
+}
+
+void gpu_culler_submit(GpuCuller *culler, RenderQueue *queue, RenderKey key)
+{
+    if (!culler || !culler->dispatched || !queue)
+    {
+        return;
+    }
+
+    render_queue_submit_indirect(queue, key, culler->visible_buffer, culler->indirect_buffer, 0);
+}
\ No newline at end of file
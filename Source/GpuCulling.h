@@ -0,0 +1,41 @@
+#ifndef _GPU_CULLING_H
+#define _GPU_CULLING_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "Math.h"
+#include "Renderer.h"
+#include "RenderQueue.h"
+
+// Compute-side culling of an instance buffer against a view rectangle. Visible quads are
+// compacted into visible_buffer and the draw is issued indirectly, so nothing is read back.
+// Visible quads keep no particular order, use it where overlap order does not matter
+typedef struct GpuCuller
+{
+    SDL_GPUDevice *device;
+    SDL_GPUComputePipeline *pipeline;
+    BatchVertexFormat format;
+    uint32_t instance_size;
+
+    SDL_GPUBuffer *visible_buffer;
+    uint32_t capacity;
+
+    // Draw arguments, reset from reset_buffer at the start of every dispatch
+    SDL_GPUBuffer *indirect_buffer;
+    SDL_GPUTransferBuffer *reset_buffer;
+
+    bool dispatched;
+} GpuCuller;
+
+bool gpu_culler_create(GpuCuller *culler, SDL_GPUDevice *device, BatchVertexFormat format, uint32_t capacity);
+void gpu_culler_destroy(GpuCuller *culler);
+
+// Records the reset copy and the cull dispatch into cmd, outside of any pass. The source
+// buffer needs COMPUTE_STORAGE_READ usage and must hold quad_count records of the culler's format
+bool gpu_culler_dispatch(GpuCuller *culler, SDL_GPUCommandBuffer *cmd, SDL_GPUBuffer *source_buffer, uint32_t quad_count, Rect2f bounds);
+
+void gpu_culler_draw(GpuCuller *culler, SDL_GPURenderPass *render_pass);
+void gpu_culler_submit(GpuCuller *culler, RenderQueue *queue, RenderKey key);
+
+#endif
\ No newline at end of file
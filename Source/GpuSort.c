@@ -0,0 +1,141 @@
+#include "GpuSort.h"
+#include "Shader.h"
+
+// Matches SortParams in sort_common.glsl (std140)
+typedef struct GpuSortParams
+{
+    uint32_t count_index;
+    uint32_t shift;
+    uint32_t capacity;
+    uint32_t padding;
+} GpuSortParams;
+
+static SDL_GPUBuffer *gpu_sort_buffer_create(SDL_GPUDevice *device, SDL_GPUBufferUsageFlags usage, uint32_t size)
+{
+    SDL_GPUBufferCreateInfo buffer_info = {0};
+    buffer_info.usage = usage;
+    buffer_info.size = size;
+
+    SDL_GPUBuffer *buffer = SDL_CreateGPUBuffer(device, &buffer_info);
+    if (!buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create sort buffer: %s", SDL_GetError());
+    }
+    return buffer;
+}
+
+// Every stage reads the params pushed right before it, they stay put for the pass
+static bool gpu_sort_dispatch(SDL_GPUCommandBuffer *cmd, SDL_GPUComputePipeline *pipeline, SDL_GPUBuffer *const *readonly_buffers,
+                              uint32_t readonly_count, SDL_GPUBuffer *const *readwrite_buffers, uint32_t readwrite_count,
+                              const GpuSortParams *params, SDL_GPUBuffer *indirect_buffer)
+{
+    SDL_PushGPUComputeUniformData(cmd, 0, params, sizeof(GpuSortParams));
+    return compute_pass_dispatch(cmd, pipeline, readonly_buffers, readonly_count, readwrite_buffers, readwrite_count,
+                                 indirect_buffer, 0, 1);
+}
+
+bool gpu_sorter_create(GpuSorter *sorter, SDL_GPUDevice *device, uint32_t capacity)
+{
+    if (!sorter || !device || capacity == 0)
+    {
+        return false;
+    }
+
+    SDL_memset(sorter, 0, sizeof(GpuSorter));
+    sorter->device = device;
+    sorter->capacity = capacity;
+
+    uint32_t tile_count = (capacity + GPU_SORT_TILE_SIZE - 1) / GPU_SORT_TILE_SIZE;
+    SDL_GPUBufferUsageFlags pair_usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+
+    sorter->keys[0] = gpu_sort_buffer_create(device, pair_usage, capacity * sizeof(uint32_t));
+    sorter->keys[1] = gpu_sort_buffer_create(device, pair_usage, capacity * sizeof(uint32_t));
+    sorter->values[0] = gpu_sort_buffer_create(device, pair_usage | SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ, capacity * sizeof(uint32_t));
+    sorter->values[1] = gpu_sort_buffer_create(device, pair_usage, capacity * sizeof(uint32_t));
+    sorter->histogram_buffer = gpu_sort_buffer_create(device, pair_usage, GPU_SORT_RADIX * tile_count * sizeof(uint32_t));
+    sorter->dispatch_buffer = gpu_sort_buffer_create(device, SDL_GPU_BUFFERUSAGE_INDIRECT | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+                                                     sizeof(SDL_GPUIndirectDispatchCommand));
+    if (!sorter->keys[0] || !sorter->keys[1] || !sorter->values[0] || !sorter->values[1] ||
+        !sorter->histogram_buffer || !sorter->dispatch_buffer)
+    {
+        gpu_sorter_destroy(sorter);
+        return false;
+    }
+
+    sorter->setup_pipeline = compute_pipeline_create(device, "Resources/Shaders/sort_setup.comp.spv", 1, 1, 1, 1);
+    sorter->histogram_pipeline = compute_pipeline_create(device, "Resources/Shaders/sort_histogram.comp.spv", 2, 1, 1, 256);
+    sorter->scan_pipeline = compute_pipeline_create(device, "Resources/Shaders/sort_scan.comp.spv", 1, 1, 1, 256);
+    sorter->scatter_pipeline = compute_pipeline_create(device, "Resources/Shaders/sort_scatter.comp.spv", 4, 2, 1, 256);
+    if (!sorter->setup_pipeline || !sorter->histogram_pipeline || !sorter->scan_pipeline || !sorter->scatter_pipeline)
+    {
+        gpu_sorter_destroy(sorter);
+        return false;
+    }
+
+    return true;
+}
+
+void gpu_sorter_destroy(GpuSorter *sorter)
+{
+    if (!sorter || !sorter->device)
+    {
+        return;
+    }
+
+    SDL_GPUComputePipeline *pipelines[4] = {sorter->setup_pipeline, sorter->histogram_pipeline, sorter->scan_pipeline, sorter->scatter_pipeline};
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        if (pipelines[i])
+        {
+            SDL_ReleaseGPUComputePipeline(sorter->device, pipelines[i]);
+        }
+    }
+
+    SDL_GPUBuffer *buffers[6] = {sorter->keys[0], sorter->keys[1], sorter->values[0], sorter->values[1],
+                                 sorter->histogram_buffer, sorter->dispatch_buffer};
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        if (buffers[i])
+        {
+            SDL_ReleaseGPUBuffer(sorter->device, buffers[i]);
+        }
+    }
+
+    SDL_memset(sorter, 0, sizeof(GpuSorter));
+}
+
+bool gpu_sorter_sort(GpuSorter *sorter, SDL_GPUCommandBuffer *cmd, SDL_GPUBuffer *count_buffer, uint32_t count_index)
+{
+    if (!sorter || !sorter->scatter_pipeline || !cmd || !count_buffer)
+    {
+        return false;
+    }
+
+    GpuSortParams params = {0};
+    params.count_index = count_index;
+    params.capacity = sorter->capacity;
+
+    if (!gpu_sort_dispatch(cmd, sorter->setup_pipeline, &count_buffer, 1, &sorter->dispatch_buffer, 1, &params, NULL))
+    {
+        return false;
+    }
+
+    for (uint32_t pass = 0; pass < GPU_SORT_PASSES; pass++)
+    {
+        uint32_t source = pass & 1;
+        params.shift = pass * 4;
+
+        SDL_GPUBuffer *histogram_inputs[2] = {count_buffer, sorter->keys[source]};
+        SDL_GPUBuffer *scatter_inputs[4] = {count_buffer, sorter->keys[source], sorter->values[source], sorter->histogram_buffer};
+        SDL_GPUBuffer *scatter_outputs[2] = {sorter->keys[source ^ 1], sorter->values[source ^ 1]};
+
+        if (!gpu_sort_dispatch(cmd, sorter->histogram_pipeline, histogram_inputs, 2, &sorter->histogram_buffer, 1, &params, sorter->dispatch_buffer) ||
+            !gpu_sort_dispatch(cmd, sorter->scan_pipeline, &count_buffer, 1, &sorter->histogram_buffer, 1, &params, NULL) ||
+            !gpu_sort_dispatch(cmd, sorter->scatter_pipeline, scatter_inputs, 4, scatter_outputs, 2, &params, sorter->dispatch_buffer))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
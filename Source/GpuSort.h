@@ -0,0 +1,43 @@
+#ifndef _GPU_SORT_H
+#define _GPU_SORT_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Must match sort_common.glsl
+#define GPU_SORT_TILE_SIZE 1024
+#define GPU_SORT_RADIX 16
+#define GPU_SORT_PASSES 8
+
+// Stable LSD radix sort of 32-bit key / value pairs, 4 key bits per pass. The pair count is
+// read from a GPU buffer and every pass is sized indirectly, so nothing is read back. Pairs are
+// written to keys[0] / values[0] and come out sorted by key in the same buffers
+typedef struct GpuSorter
+{
+    SDL_GPUDevice *device;
+    SDL_GPUComputePipeline *setup_pipeline;
+    SDL_GPUComputePipeline *histogram_pipeline;
+    SDL_GPUComputePipeline *scan_pipeline;
+    SDL_GPUComputePipeline *scatter_pipeline;
+
+    // Ping-pong pairs, an even pass count ends back in [0]
+    SDL_GPUBuffer *keys[2];
+    SDL_GPUBuffer *values[2];
+
+    // Digit counts per tile, digit-major, scanned in place into output offsets
+    SDL_GPUBuffer *histogram_buffer;
+    SDL_GPUBuffer *dispatch_buffer;
+    uint32_t capacity;
+} GpuSorter;
+
+// values[0] also gets GRAPHICS_STORAGE_READ usage, so draws can read the sorted order directly
+bool gpu_sorter_create(GpuSorter *sorter, SDL_GPUDevice *device, uint32_t capacity);
+void gpu_sorter_destroy(GpuSorter *sorter);
+
+// Records the sort into cmd, outside of any pass. Word count_index of count_buffer holds the
+// number of pairs (clamped to the capacity), the buffer needs COMPUTE_STORAGE_READ usage.
+// Overwrites compute uniform slot 0
+bool gpu_sorter_sort(GpuSorter *sorter, SDL_GPUCommandBuffer *cmd, SDL_GPUBuffer *count_buffer, uint32_t count_index);
+
+#endif
\ No newline at end of file
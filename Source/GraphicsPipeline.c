@@ -7,7 +7,13 @@ SDL_GPUGraphicsPipeline *graphics_pipeline_create(SDL_GPUDevice *device, Graphic
 {
     SDL_GPUColorTargetDescription color_target_description = {0};
     color_target_description.format = desc->format;
-    color_target_description.blend_state.enable_blend = false;
+    color_target_description.blend_state.enable_blend = desc->enable_blend;
+    color_target_description.blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+    color_target_description.blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+    color_target_description.blend_state.color_blend_op = SDL_GPU_BLENDOP_ADD;
+    color_target_description.blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE;
+    color_target_description.blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+    color_target_description.blend_state.alpha_blend_op = SDL_GPU_BLENDOP_ADD;
     color_target_description.blend_state.enable_color_write_mask = true;
     color_target_description.blend_state.color_write_mask = SDL_GPU_COLORCOMPONENT_R |
                                                             SDL_GPU_COLORCOMPONENT_G |
@@ -5,11 +5,16 @@
 #include "Buffers.h"
 #include "Renderer.h"
 #include "ParticleSystem.h"
+#include "StaticBatch.h"
+#include "GpuCulling.h"
+#include "Benchmark.h"
 
 #include "Math.h"
 
 #include "cglm/cglm.h"
 
+#include <float.h>
+
 typedef struct Camera
 {
     vec3 position;
@@ -30,6 +35,93 @@ void camera_update_matrices(Camera *camera, int width, int height, mat4 view_pro
     glm_mat4_mul(camera->projection, camera->view, view_projection);
 }
 
+// World-space rectangle the camera sees on the z = 0 plane, false when a corner ray misses it
+bool camera_visible_rect(mat4 view_projection, Rect2f *out_rect)
+{
+    mat4 inverse_view_projection;
+    glm_mat4_inv(view_projection, inverse_view_projection);
+
+    const float corners[4][2] = { {-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f} };
+    Rect2f rect = { {FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX} };
+
+    for (int i = 0; i < 4; i++)
+    {
+        // Two points on the corner's ray, valid for either clip depth convention
+        vec4 near_point = { corners[i][0], corners[i][1], 0.0f, 1.0f };
+        vec4 far_point = { corners[i][0], corners[i][1], 0.5f, 1.0f };
+        glm_mat4_mulv(inverse_view_projection, near_point, near_point);
+        glm_mat4_mulv(inverse_view_projection, far_point, far_point);
+        glm_vec4_scale(near_point, 1.0f / near_point[3], near_point);
+        glm_vec4_scale(far_point, 1.0f / far_point[3], far_point);
+
+        float delta_z = far_point[2] - near_point[2];
+        if (SDL_fabsf(delta_z) < 1e-6f)
+        {
+            return false;
+        }
+
+        float t = -near_point[2] / delta_z;
+        float x = near_point[0] + (far_point[0] - near_point[0]) * t;
+        float y = near_point[1] + (far_point[1] - near_point[1]) * t;
+
+        rect.min.x = x < rect.min.x ? x : rect.min.x;
+        rect.min.y = y < rect.min.y ? y : rect.min.y;
+        rect.max.x = x > rect.max.x ? x : rect.max.x;
+        rect.max.y = y > rect.max.y ? y : rect.max.y;
+    }
+
+    *out_rect = rect;
+    return true;
+}
+
+static SDL_GPUGraphicsPipeline *create_2d_pipeline(SDL_GPUDevice *device, BatchVertexFormat format)
+{
+    Shader vertex_shader_2d = shader_create(device, SDL_GPU_SHADERSTAGE_VERTEX, batch_vertex_format_shader(format), "main");
+    Shader fragment_shader_2d = shader_create(device, SDL_GPU_SHADERSTAGE_FRAGMENT, batch_vertex_format_fragment_shader(format), "main");
+
+    // Log the reflected vertex attributes
+    SDL_Log("Vertex shader has %u attributes:", vertex_shader_2d.reflection_info.vertex_attribute_count);
+    for (uint32_t i = 0; i < vertex_shader_2d.reflection_info.vertex_attribute_count; ++i)
+    {
+        SDL_GPUVertexAttribute *attr = &vertex_shader_2d.reflection_info.vertex_attributes[i];
+        SDL_Log("  Attribute %u: location=%u, buffer_slot=%u, format=%d, offset=%u", i, attr->location, attr->buffer_slot, attr->format, attr->offset);
+    }
+
+    SDL_GPUVertexBufferDescription vertex_buffer_desc = {0};
+    vertex_buffer_desc.slot = 0;
+    vertex_buffer_desc.pitch = vertex_shader_2d.reflection_info.vertex_stride;
+    vertex_buffer_desc.input_rate = SDL_GPU_VERTEXINPUTRATE_INSTANCE;
+    vertex_buffer_desc.instance_step_rate = 0;
+
+    GraphicsPipelineDescription desc_2d = {0};
+    desc_2d.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+    desc_2d.front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE;
+    desc_2d.format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+    desc_2d.fill_mode = SDL_GPU_FILLMODE_FILL;
+    desc_2d.cull_mode = SDL_GPU_CULLMODE_NONE;
+    desc_2d.compare_op = SDL_GPU_COMPAREOP_ALWAYS;
+    desc_2d.vertex_shader = vertex_shader_2d.handle;
+    desc_2d.fragment_shader = fragment_shader_2d.handle;
+    desc_2d.enable_depth_test = false;
+    desc_2d.enable_depth_write = false;
+    desc_2d.enable_blend = format == BATCH_VERTEX_FORMAT_SHAPE; // anti-aliased shape edges
+    desc_2d.vertex_buffer_descriptions = &vertex_buffer_desc;
+    desc_2d.num_vertex_buffers = 1;
+    desc_2d.vertex_attributes = vertex_shader_2d.reflection_info.vertex_attributes;
+    desc_2d.num_vertex_attributes = vertex_shader_2d.reflection_info.vertex_attribute_count;
+    desc_2d.num_samplers = 0;
+
+    SDL_GPUGraphicsPipeline *pipeline = graphics_pipeline_create(device, &desc_2d);
+    if (!pipeline)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create 2D pipeline");
+    }
+    shader_release(device, &vertex_shader_2d);
+    shader_release(device, &fragment_shader_2d);
+
+    return pipeline;
+}
+
 int main(int argc, char **argv)
 {
     if (!SDL_Init(SDL_INIT_VIDEO))
@@ -38,6 +130,27 @@ int main(int argc, char **argv)
         return -1;
     }
 
+    // --compact selects the half-float instance format, --benchmark compares both formats and exits,
+    // --cpu-particles simulates particles on the CPU instead of in compute passes
+    BatchVertexFormat batch_format = BATCH_VERTEX_FORMAT_FULL;
+    bool run_benchmark = false;
+    bool cpu_particles = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (SDL_strcmp(argv[i], "--compact") == 0)
+        {
+            batch_format = BATCH_VERTEX_FORMAT_COMPACT;
+        }
+        else if (SDL_strcmp(argv[i], "--benchmark") == 0)
+        {
+            run_benchmark = true;
+        }
+        else if (SDL_strcmp(argv[i], "--cpu-particles") == 0)
+        {
+            cpu_particles = true;
+        }
+    }
+
     Window window = {0};
     create_window(&window, "KROMA", 720, 540);
     create_gpu_device(&window);
@@ -66,17 +179,98 @@ int main(int argc, char **argv)
 
     SDL_GPUSampler *sampler = SDL_CreateGPUSampler(window.device, &sampler_info);
 
-    // Initialize batch renderer (supports up to 1 million quads)
+    // Persistent staging memory for per-frame uploads
+    StagingRing staging_ring = {0};
+    if (!staging_ring_create(&staging_ring, window.device, STAGING_RING_DEFAULT_FRAME_SIZE))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create staging ring");
+        SDL_Quit();
+        return -1;
+    }
+
+    UploadQueue upload_queue = {0};
+    if (!upload_queue_create(&upload_queue, &staging_ring, 64))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create upload queue");
+        staging_ring_destroy(&staging_ring);
+        SDL_Quit();
+        return -1;
+    }
+
+    // Background streaming for large one-off uploads
+    AsyncUploader async_uploader = {0};
+    if (!async_uploader_create(&async_uploader, window.device))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create async uploader");
+        upload_queue_destroy(&upload_queue);
+        staging_ring_destroy(&staging_ring);
+        SDL_Quit();
+        return -1;
+    }
+
+    // Initialize batch renderer (grows in chunks as needed)
     BatchRenderer2D batch_renderer = {0};
-    if (!batch_renderer_2d_init(&batch_renderer, window.device))
+    if (!batch_renderer_2d_init(&batch_renderer, window.device, &upload_queue, batch_format))
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize batch renderer");
+        async_uploader_destroy(&async_uploader);
+        upload_queue_destroy(&upload_queue);
+        staging_ring_destroy(&staging_ring);
         SDL_Quit();
         return -1;
     }
 
+    // Scene draws are sorted by key before they are recorded
+    RenderQueue render_queue = {0};
+    if (!render_queue_create(&render_queue, 64))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create render queue");
+        batch_renderer_2d_destroy(&batch_renderer);
+        async_uploader_destroy(&async_uploader);
+        upload_queue_destroy(&upload_queue);
+        staging_ring_destroy(&staging_ring);
+        SDL_Quit();
+        return -1;
+    }
+
+    // Background tiles are built once and only re-uploaded when they change
+    StaticBatch2D background_batch = {0};
+    if (!static_batch_2d_create(&background_batch, window.device, &upload_queue, batch_format, 0))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create background batch");
+        render_queue_destroy(&render_queue);
+        batch_renderer_2d_destroy(&batch_renderer);
+        async_uploader_destroy(&async_uploader);
+        upload_queue_destroy(&upload_queue);
+        staging_ring_destroy(&staging_ring);
+        SDL_Quit();
+        return -1;
+    }
+
+    for (int y = -16; y < 16; y++)
+    {
+        for (int x = -16; x < 16; x++)
+        {
+            float shade = ((x + y) & 1) ? 0.12f : 0.14f;
+            static_batch_2d_add(&background_batch, (Vector2f){x + 0.5f, y + 0.5f}, (Vector2f){1.0f, 1.0f},
+                                (Vector4f){shade, shade, shade, 1.0f});
+        }
+    }
+
+    // The background is culled on the GPU and drawn indirectly, falling back to one full draw
+    GpuCuller background_culler = {0};
+    bool gpu_culling = gpu_culler_create(&background_culler, window.device, batch_format, STATIC_BATCH_DEFAULT_CAPACITY);
+    if (!gpu_culling)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "GPU culling unavailable, the background is drawn unculled");
+    }
+
     SDL_GPUGraphicsPipeline *composite_pipeline = NULL;
     SDL_GPUGraphicsPipeline *two_dimension_pipeline = NULL;
+    uint32_t two_dimension_pipeline_id = RENDER_PIPELINE_NONE;
+    SDL_GPUGraphicsPipeline *particle_pipeline = NULL;
+    SDL_GPUGraphicsPipeline *overlay_pipeline = NULL;
+    uint32_t overlay_pipeline_id = RENDER_PIPELINE_NONE;
 
     SDL_Event event;
     bool running = true;
@@ -92,20 +286,98 @@ int main(int argc, char **argv)
     camera_update_matrices(&camera, (float)window.width, (float)window.height, view_projection);
     uniform_buffer_update(window.device, &view_projection_buffer, view_projection, sizeof(mat4));
 
-    // Create particle emitter
-    ParticleEmitter particle_emitter = {0};
-    if (!particle_emitter_create(&particle_emitter, window.device, (Vector2f){0.0f, 0.0f}, 5000))
+    // Only quads inside the camera's view reach the batch
+    Rect2f view_rect;
+    bool view_rect_valid = camera_visible_rect(view_projection, &view_rect);
+    if (view_rect_valid)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle emitter");
+        batch_renderer_2d_set_cull_rect(&batch_renderer, view_rect);
+    }
+
+    // One particle system for every emitter in the scene
+    ParticleSystem particle_system = {0};
+    bool particles_created = cpu_particles ?
+        particle_system_create_cpu(&particle_system, 256 * 1024, 64, 0) :
+        particle_system_create(&particle_system, window.device, &upload_queue, &async_uploader, 256 * 1024, 64);
+    if (!particles_created)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle system");
+        gpu_culler_destroy(&background_culler);
+        static_batch_2d_destroy(&background_batch);
+        render_queue_destroy(&render_queue);
         batch_renderer_2d_destroy(&batch_renderer);
+        async_uploader_destroy(&async_uploader);
+        upload_queue_destroy(&upload_queue);
+        staging_ring_destroy(&staging_ring);
         SDL_Quit();
         return -1;
     }
     
-    // Set particle emitter properties
-    particle_emitter_set_gravity(&particle_emitter, 5.0f);
-    particle_emitter_set_damping(&particle_emitter, 0.2f);
+    // The mouse drags the first emitter, a ring of quieter ones sits around the origin
+    ParticleEmitterHandle mouse_emitter = particle_system_add_emitter(&particle_system, (Vector2f){0.0f, 0.0f}, 5000.0f / PARTICLE_AVERAGE_LIFETIME);
+    particle_emitter_set_gravity(particle_system_get_emitter(&particle_system, mouse_emitter), 5.0f);
+    particle_emitter_set_damping(particle_system_get_emitter(&particle_system, mouse_emitter), 0.2f);
+    particle_emitter_set_layer(particle_system_get_emitter(&particle_system, mouse_emitter), 1);
+    
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        float angle = (float)i * (2.0f * SDL_PI_F / 8.0f);
+        Vector2f position = {SDL_cosf(angle) * 4.0f, SDL_sinf(angle) * 4.0f};
+        ParticleEmitterHandle handle = particle_system_add_emitter(&particle_system, position, 300.0f);
+        particle_emitter_set_gravity(particle_system_get_emitter(&particle_system, handle), -2.0f - (float)i);
+        particle_emitter_set_depth(particle_system_get_emitter(&particle_system, handle), (float)i / 8.0f);
+    }
+    
+    // Sorted particles can alpha blend, without sorting they are drawn opaque
+    if (!cpu_particles && !particle_system_enable_sorting(&particle_system))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Particle sorting unavailable, drawing particles unblended");
+    }
+    
+    // Neighbors keep a little distance and drift together, flocking the denser streams
+    ParticleGridSettings interaction = {0};
+    interaction.radius = 0.2f;
+    interaction.separation = 4.0f;
+    interaction.cohesion = 0.5f;
+    interaction.alignment = 1.0f;
+    interaction.max_neighbors = PARTICLE_GRID_DEFAULT_MAX_NEIGHBORS;
+    if (!cpu_particles && !particle_system_enable_interaction(&particle_system, 0, interaction))
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Particle interaction unavailable");
+    }
+
+    // Debug overlay of SDF shapes, drawn above everything else
+    BatchRenderer2D overlay_renderer = {0};
+    bool overlay_enabled = batch_renderer_2d_init(&overlay_renderer, window.device, &upload_queue, BATCH_VERTEX_FORMAT_SHAPE);
+    if (!overlay_enabled)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize debug overlay");
+    }
     
+    if (run_benchmark)
+    {
+        SDL_GPUGraphicsPipeline *benchmark_pipelines[BATCH_VERTEX_FORMAT_COUNT] = {0};
+        for (uint32_t i = 0; i < BATCH_VERTEX_FORMAT_COUNT; i++)
+        {
+            benchmark_pipelines[i] = create_2d_pipeline(window.device, (BatchVertexFormat)i);
+        }
+
+        BenchmarkContext benchmark_context = {0};
+        benchmark_context.device = window.device;
+        benchmark_context.upload_queue = &upload_queue;
+        benchmark_context.target = scene_texture;
+        benchmark_context.view_projection = view_projection_buffer.buffer;
+        benchmark_batch_formats(&benchmark_context, benchmark_pipelines, BENCHMARK_DEFAULT_QUADS, BENCHMARK_DEFAULT_ITERATIONS);
+        benchmark_batch_threads(&benchmark_context, BENCHMARK_DEFAULT_QUADS, (uint32_t)SDL_GetNumLogicalCPUCores(), BENCHMARK_DEFAULT_ITERATIONS);
+        benchmark_particle_sort(&benchmark_context, BENCHMARK_DEFAULT_ITERATIONS);
+
+        for (uint32_t i = 0; i < BATCH_VERTEX_FORMAT_COUNT; i++)
+        {
+            graphics_pipeline_destroy(window.device, benchmark_pipelines[i]);
+        }
+        running = false;
+    }
+
     uint64_t last_time = SDL_GetPerformanceCounter();
     uint64_t frequency = SDL_GetPerformanceFrequency();
 
@@ -116,8 +388,8 @@ int main(int argc, char **argv)
         float delta_time = (float)(current_time - last_time) / (float)frequency;
         last_time = current_time;
         
-        // Update particle emitter
-        particle_emitter_update(&particle_emitter, delta_time);
+        // Recycle the oldest frame's staging memory
+        staging_ring_begin_frame(&staging_ring);
         
         while (SDL_PollEvent(&event))
         {
@@ -140,6 +412,16 @@ int main(int argc, char **argv)
                     // Update camera immediately
                     camera_update_matrices(&camera, (float)window.width, (float)window.height, view_projection);
                     uniform_buffer_update(window.device, &view_projection_buffer, view_projection, sizeof(mat4));
+
+                    view_rect_valid = camera_visible_rect(view_projection, &view_rect);
+                    if (view_rect_valid)
+                    {
+                        batch_renderer_2d_set_cull_rect(&batch_renderer, view_rect);
+                    }
+                    else
+                    {
+                        batch_renderer_2d_disable_culling(&batch_renderer);
+                    }
                     break;
                 }
                 case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
@@ -172,7 +454,7 @@ int main(int argc, char **argv)
                         float world_x = -ndc_x * (view_width / 2.0f);
                         float world_y = ndc_y * (view_height / 2.0f); // Flip Y
                         
-                        particle_emitter_set_position(&particle_emitter, (Vector2f){world_x, world_y});
+                        particle_emitter_set_position(particle_system_get_emitter(&particle_system, mouse_emitter), (Vector2f){world_x, world_y});
                     }
                     break;
                 }
@@ -201,7 +483,7 @@ int main(int argc, char **argv)
                         float world_x = -ndc_x * (view_width / 2.0f);
                         float world_y = ndc_y * (view_height / 2.0f); // Flip Y
                         
-                        particle_emitter_set_position(&particle_emitter, (Vector2f){world_x, world_y});
+                        particle_emitter_set_position(particle_system_get_emitter(&particle_system, mouse_emitter), (Vector2f){world_x, world_y});
                     }
                     break;
                 }
@@ -210,85 +492,17 @@ int main(int argc, char **argv)
 
         if (!composite_pipeline)
         {
-            // Create 2D pipeline
-            Shader vertex_shader_2d = shader_create(window.device, SDL_GPU_SHADERSTAGE_VERTEX, "Resources/Shaders/2d.vert.spv", "main");
-            Shader fragment_shader_2d = shader_create(window.device, SDL_GPU_SHADERSTAGE_FRAGMENT, "Resources/Shaders/2d.frag.spv", "main");
-
-            // Log the reflected vertex attributes
-            SDL_Log("Vertex shader has %u attributes:", vertex_shader_2d.reflection_info.vertex_attribute_count);
-            for (uint32_t i = 0; i < vertex_shader_2d.reflection_info.vertex_attribute_count; ++i)
-            {
-                SDL_GPUVertexAttribute *attr = &vertex_shader_2d.reflection_info.vertex_attributes[i];
-                SDL_Log("  Attribute %u: location=%u, buffer_slot=%u, format=%d, offset=%u", i, attr->location, attr->buffer_slot, attr->format, attr->offset);
-            }
+            // Create 2D pipeline for the selected instance format
+            two_dimension_pipeline = create_2d_pipeline(window.device, batch_format);
+            two_dimension_pipeline_id = render_queue_register_pipeline(&render_queue, two_dimension_pipeline);
 
-            // Calculate vertex stride from reflected attributes
-            uint32_t vertex_stride = 0;
-            for (uint32_t i = 0; i < vertex_shader_2d.reflection_info.vertex_attribute_count; ++i)
-            {
-                SDL_GPUVertexAttribute *attr = &vertex_shader_2d.reflection_info.vertex_attributes[i];
-                uint32_t attr_size = 0;
-                
-                // Calculate size based on format
-                switch (attr->format)
-                {
-                    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_INT:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_UINT:
-                        attr_size = 4;
-                        break;
-                    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_INT2:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_UINT2:
-                        attr_size = 8;
-                        break;
-                    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_INT3:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_UINT3:
-                        attr_size = 12;
-                        break;
-                    case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_INT4:
-                    case SDL_GPU_VERTEXELEMENTFORMAT_UINT4:
-                        attr_size = 16;
-                        break;
-                    default:
-                        break;
-                }
-                vertex_stride += attr_size;
-            }
+            particle_pipeline = particle_render_pipeline_create(window.device, SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM, particle_system.sorting);
 
-            SDL_GPUVertexBufferDescription vertex_buffer_desc = {0};
-            vertex_buffer_desc.slot = 0;
-            vertex_buffer_desc.pitch = vertex_stride;
-            vertex_buffer_desc.input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
-            vertex_buffer_desc.instance_step_rate = 0;
-
-            GraphicsPipelineDescription desc_2d = {0};
-            desc_2d.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
-            desc_2d.front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE;
-            desc_2d.format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
-            desc_2d.fill_mode = SDL_GPU_FILLMODE_FILL;
-            desc_2d.cull_mode = SDL_GPU_CULLMODE_NONE;
-            desc_2d.compare_op = SDL_GPU_COMPAREOP_ALWAYS;
-            desc_2d.vertex_shader = vertex_shader_2d.handle;
-            desc_2d.fragment_shader = fragment_shader_2d.handle;
-            desc_2d.enable_depth_test = false;
-            desc_2d.enable_depth_write = false;
-            desc_2d.enable_blend = false;
-            desc_2d.vertex_buffer_descriptions = &vertex_buffer_desc;
-            desc_2d.num_vertex_buffers = 1;
-            desc_2d.vertex_attributes = vertex_shader_2d.reflection_info.vertex_attributes;
-            desc_2d.num_vertex_attributes = vertex_shader_2d.reflection_info.vertex_attribute_count;
-            desc_2d.num_samplers = 0;
-
-            two_dimension_pipeline = graphics_pipeline_create(window.device, &desc_2d);
-            if (!two_dimension_pipeline)
+            if (overlay_enabled)
             {
-                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create 2D pipeline");
+                overlay_pipeline = create_2d_pipeline(window.device, BATCH_VERTEX_FORMAT_SHAPE);
+                overlay_pipeline_id = render_queue_register_pipeline(&render_queue, overlay_pipeline);
             }
-            shader_release(window.device, &vertex_shader_2d);
-            shader_release(window.device, &fragment_shader_2d);
 
             // Create composite pipeline
             Shader vertex_shader = shader_create(window.device,
@@ -338,6 +552,73 @@ int main(int argc, char **argv)
             break;
         }
 
+        // Build batch of quads
+        batch_renderer_2d_begin(&batch_renderer);
+        
+        // CPU particles are simulated here and drawn as batch quads
+        if (particle_system.backend == PARTICLE_BACKEND_CPU)
+        {
+            particle_system_update(&particle_system, delta_time);
+            particle_system_render(&particle_system, &batch_renderer);
+        }
+        
+        batch_renderer_2d_end(&batch_renderer);
+
+        if (overlay_enabled)
+        {
+            // World axes and a ring around every emitter
+            Vector4f axis_color = {0.35f, 0.35f, 0.4f, 0.8f};
+            batch_renderer_2d_begin(&overlay_renderer);
+            batch_renderer_2d_add_line(&overlay_renderer, (Vector2f){-16.0f, 0.0f}, (Vector2f){16.0f, 0.0f}, 0.03f, axis_color);
+            batch_renderer_2d_add_line(&overlay_renderer, (Vector2f){0.0f, -16.0f}, (Vector2f){0.0f, 16.0f}, 0.03f, axis_color);
+            for (uint32_t i = 0; i < particle_system.emitter_count; i++)
+            {
+                const ParticleEmitter *emitter = &particle_system.emitters[i];
+                if (emitter->active)
+                {
+                    float radius = i + 1 == mouse_emitter ? 0.5f : 0.25f;
+                    batch_renderer_2d_add_circle(&overlay_renderer, emitter->position, radius, 0.04f, (Vector4f){1.0f, 0.8f, 0.2f, 0.9f});
+                }
+            }
+            batch_renderer_2d_end(&overlay_renderer);
+        }
+
+        static_batch_2d_flush(&background_batch);
+
+        // The emitter table changes join the frame's uploads
+        if (particle_system.backend == PARTICLE_BACKEND_GPU)
+        {
+            particle_system_stage_uploads(&particle_system, delta_time);
+        }
+
+        // All of this frame's uploads in one copy pass, ahead of the render passes
+        upload_queue_flush(&upload_queue, cmd);
+
+        // Every emitter is simulated in the frame's command buffer, ahead of the scene pass
+        bool particles_updated = particle_system.backend == PARTICLE_BACKEND_GPU &&
+            particle_system_record_update(&particle_system, cmd);
+
+        // Recorded after the flush so the cull pass sees this frame's background records
+        bool background_culled = gpu_culling && view_rect_valid &&
+            gpu_culler_dispatch(&background_culler, cmd, background_batch.instance_buffer, background_batch.quad_count, view_rect);
+
+        // Static background on layer 0, dynamic quads on top of it
+        render_queue_reset(&render_queue);
+        RenderKey background_key = render_key_make(0, two_dimension_pipeline_id, RENDER_TEXTURE_NONE, 0);
+        if (background_culled)
+        {
+            gpu_culler_submit(&background_culler, &render_queue, background_key);
+        }
+        else
+        {
+            static_batch_2d_submit(&background_batch, &render_queue, background_key);
+        }
+        batch_renderer_2d_submit(&batch_renderer, &render_queue, render_key_make(1, two_dimension_pipeline_id, RENDER_TEXTURE_NONE, 0));
+        if (overlay_enabled)
+        {
+            batch_renderer_2d_submit(&overlay_renderer, &render_queue, render_key_make(2, overlay_pipeline_id, RENDER_TEXTURE_NONE, 0));
+        }
+
         // First pass: Render 2D quad to scene render target
         {
             SDL_GPUColorTargetInfo scene_target_info = {0};
@@ -351,26 +632,19 @@ int main(int argc, char **argv)
             scene_target_info.cycle = false;
 
             SDL_GPURenderPass *scene_pass = SDL_BeginGPURenderPass(cmd, &scene_target_info, 1, NULL);
-            if (scene_pass && two_dimension_pipeline)
+            if (scene_pass)
             {
-                SDL_BindGPUGraphicsPipeline(scene_pass, two_dimension_pipeline);
-                
                 // Bind uniform buffer
                 SDL_GPUBufferBinding uniform_binding = {0};
                 uniform_binding.buffer = view_projection_buffer.buffer;
                 uniform_binding.offset = 0;
                 SDL_BindGPUVertexStorageBuffers(scene_pass, 0, &uniform_binding, 1);
                 
-                // Build batch of quads
-                batch_renderer_2d_begin(&batch_renderer);
-                
-                // Render particles
-                particle_emitter_render(&particle_emitter, &batch_renderer);
-                
-                batch_renderer_2d_end(&batch_renderer);
-                
-                // Draw all batched quads
-                batch_renderer_2d_draw(&batch_renderer, scene_pass);
+                // Sorted draws with redundant binds removed
+                render_queue_execute(&render_queue, scene_pass);
+
+                // Particles are expanded from the simulation buffer, no readback
+                particle_system_draw(&particle_system, scene_pass, particle_pipeline);
                 
                 SDL_EndGPURenderPass(scene_pass);
             }
@@ -404,21 +678,43 @@ int main(int argc, char **argv)
             }
         }
 
-        if (!SDL_SubmitGPUCommandBuffer(cmd))
+        SDL_GPUFence *frame_fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+        if (!frame_fence)
         {
             SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit GPU command buffer: %s", SDL_GetError());
             break;
         }
+        staging_ring_end_frame(&staging_ring, frame_fence);
+
+        if (particles_updated)
+        {
+            particle_system_request_readback(&particle_system);
+        }
     }
 
     SDL_WaitForGPUIdle(window.device);
 
     graphics_pipeline_destroy(window.device, composite_pipeline);
     graphics_pipeline_destroy(window.device, two_dimension_pipeline);
+    if (particle_pipeline)
+    {
+        graphics_pipeline_destroy(window.device, particle_pipeline);
+    }
+    if (overlay_pipeline)
+    {
+        graphics_pipeline_destroy(window.device, overlay_pipeline);
+    }
     
-    particle_emitter_destroy(&particle_emitter);
+    particle_system_destroy(&particle_system);
+    render_queue_destroy(&render_queue);
+    gpu_culler_destroy(&background_culler);
+    static_batch_2d_destroy(&background_batch);
+    batch_renderer_2d_destroy(&overlay_renderer);
     batch_renderer_2d_destroy(&batch_renderer);
     uniform_buffer_destroy(window.device, &view_projection_buffer);
+    async_uploader_destroy(&async_uploader);
+    upload_queue_destroy(&upload_queue);
+    staging_ring_destroy(&staging_ring);
     
     SDL_ReleaseGPUSampler(window.device, sampler);
     SDL_ReleaseGPUTexture(window.device, scene_texture);
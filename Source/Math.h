@@ -17,6 +17,10 @@ typedef struct Vector4f
     float x, y, z, w;
 } Vector4f;
 
+typedef struct Rect2f
+{
+    Vector2f min, max;
+} Rect2f;
 
 // INTEGER
 typedef struct Vector2i
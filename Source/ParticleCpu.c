@@ -0,0 +1,649 @@
+#include "ParticleCpu.h"
+#include "ParticleSystem.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PARTICLE_CPU_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PARTICLE_CPU_NEON 1
+#include <arm_neon.h>
+#endif
+
+// MSVC compiles intrinsics for any target, GCC and Clang need them enabled per function
+#if defined(PARTICLE_CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PARTICLE_CPU_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PARTICLE_CPU_TARGET_AVX2
+#endif
+
+// Floats between two emitter table entries, for gathers
+#define PARTICLE_CPU_EMITTER_STRIDE (sizeof(EmitterData) / sizeof(float))
+
+void particle_random(uint32_t seed, uint32_t spawn, uint32_t draw, float out[2])
+{
+    uint32_t counter_x = spawn;
+    uint32_t counter_y = draw;
+    uint32_t key = seed;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        uint64_t product = (uint64_t)0xD256D193u * counter_x;
+        counter_x = (uint32_t)(product >> 32) ^ key ^ counter_y;
+        counter_y = (uint32_t)product;
+        key += 0x9E3779B9u;
+    }
+
+    // 24 bits per float, the conversion is exact on every backend
+    out[0] = (float)(counter_x >> 8) * (1.0f / 16777216.0f);
+    out[1] = (float)(counter_y >> 8) * (1.0f / 16777216.0f);
+}
+
+// The integration below follows particles.comp line by line: lifetime first, gravity, damping,
+// position, then the alpha fade over the ~4 second maximum lifetime
+static uint32_t simulate_particles_scalar(ParticleCpuPool *pool, const EmitterData *emitters, uint32_t first,
+                                          uint32_t count, float delta_time, uint32_t *out_died)
+{
+    uint32_t died_count = 0;
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        if (pool->lifetime[i] <= 0.0f)
+        {
+            continue;
+        }
+
+        float lifetime = pool->lifetime[i] - delta_time;
+        if (lifetime <= 0.0f)
+        {
+            pool->lifetime[i] = 0.0f;
+            out_died[died_count++] = i;
+            continue;
+        }
+
+        const EmitterData *emitter = &emitters[pool->emitter[i]];
+        float damping = 1.0f - emitter->damping * delta_time;
+        float velocity_x = pool->velocity_x[i] * damping;
+        float velocity_y = (pool->velocity_y[i] + emitter->gravity * delta_time) * damping;
+
+        pool->velocity_x[i] = velocity_x;
+        pool->velocity_y[i] = velocity_y;
+        pool->position_x[i] += velocity_x * delta_time;
+        pool->position_y[i] += velocity_y * delta_time;
+        pool->color_a[i] = SDL_clamp(lifetime * 0.25f, 0.0f, 1.0f);
+        pool->lifetime[i] = lifetime;
+    }
+    return died_count;
+}
+
+#if defined(PARTICLE_CPU_X86)
+
+static __m128 blend_sse2(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static uint32_t simulate_particles_sse2(ParticleCpuPool *pool, const EmitterData *emitters, uint32_t first,
+                                        uint32_t count, float delta_time, uint32_t *out_died)
+{
+    __m128 dt = _mm_set1_ps(delta_time);
+    __m128 zero = _mm_setzero_ps();
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 quarter = _mm_set1_ps(0.25f);
+
+    uint32_t died_count = 0;
+    uint32_t end = first + count;
+    uint32_t i = first;
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 old_lifetime = _mm_loadu_ps(&pool->lifetime[i]);
+        __m128 alive = _mm_cmpgt_ps(old_lifetime, zero);
+        int alive_mask = _mm_movemask_ps(alive);
+        if (alive_mask == 0)
+        {
+            continue;
+        }
+
+        __m128 lifetime = _mm_sub_ps(old_lifetime, dt);
+        __m128 living = _mm_and_ps(alive, _mm_cmpgt_ps(lifetime, zero));
+        int died_mask = alive_mask & ~_mm_movemask_ps(living);
+
+        // SSE2 has no gather, emitter settings are loaded lane by lane
+        const EmitterData *e0 = &emitters[pool->emitter[i + 0]];
+        const EmitterData *e1 = &emitters[pool->emitter[i + 1]];
+        const EmitterData *e2 = &emitters[pool->emitter[i + 2]];
+        const EmitterData *e3 = &emitters[pool->emitter[i + 3]];
+        __m128 gravity = _mm_setr_ps(e0->gravity, e1->gravity, e2->gravity, e3->gravity);
+        __m128 damping = _mm_sub_ps(one, _mm_mul_ps(_mm_setr_ps(e0->damping, e1->damping, e2->damping, e3->damping), dt));
+
+        __m128 old_velocity_x = _mm_loadu_ps(&pool->velocity_x[i]);
+        __m128 old_velocity_y = _mm_loadu_ps(&pool->velocity_y[i]);
+        __m128 old_position_x = _mm_loadu_ps(&pool->position_x[i]);
+        __m128 old_position_y = _mm_loadu_ps(&pool->position_y[i]);
+        __m128 old_alpha = _mm_loadu_ps(&pool->color_a[i]);
+
+        __m128 velocity_x = _mm_mul_ps(old_velocity_x, damping);
+        __m128 velocity_y = _mm_mul_ps(_mm_add_ps(old_velocity_y, _mm_mul_ps(gravity, dt)), damping);
+        __m128 position_x = _mm_add_ps(old_position_x, _mm_mul_ps(velocity_x, dt));
+        __m128 position_y = _mm_add_ps(old_position_y, _mm_mul_ps(velocity_y, dt));
+        __m128 alpha = _mm_min_ps(_mm_max_ps(_mm_mul_ps(lifetime, quarter), zero), one);
+
+        // Only living lanes move, dying lanes keep everything but the lifetime, which drops to 0
+        _mm_storeu_ps(&pool->velocity_x[i], blend_sse2(living, velocity_x, old_velocity_x));
+        _mm_storeu_ps(&pool->velocity_y[i], blend_sse2(living, velocity_y, old_velocity_y));
+        _mm_storeu_ps(&pool->position_x[i], blend_sse2(living, position_x, old_position_x));
+        _mm_storeu_ps(&pool->position_y[i], blend_sse2(living, position_y, old_position_y));
+        _mm_storeu_ps(&pool->color_a[i], blend_sse2(living, alpha, old_alpha));
+        _mm_storeu_ps(&pool->lifetime[i], _mm_or_ps(_mm_and_ps(living, lifetime), _mm_andnot_ps(alive, old_lifetime)));
+
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            out_died[died_count] = i + lane;
+            died_count += (died_mask >> lane) & 1;
+        }
+    }
+
+    return died_count + simulate_particles_scalar(pool, emitters, i, end - i, delta_time, out_died + died_count);
+}
+
+PARTICLE_CPU_TARGET_AVX2
+static uint32_t simulate_particles_avx2(ParticleCpuPool *pool, const EmitterData *emitters, uint32_t first,
+                                        uint32_t count, float delta_time, uint32_t *out_died)
+{
+    __m256 dt = _mm256_set1_ps(delta_time);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 quarter = _mm256_set1_ps(0.25f);
+    __m256i stride = _mm256_set1_epi32((int)PARTICLE_CPU_EMITTER_STRIDE);
+
+    uint32_t died_count = 0;
+    uint32_t end = first + count;
+    uint32_t i = first;
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 old_lifetime = _mm256_loadu_ps(&pool->lifetime[i]);
+        __m256 alive = _mm256_cmp_ps(old_lifetime, zero, _CMP_GT_OQ);
+        int alive_mask = _mm256_movemask_ps(alive);
+        if (alive_mask == 0)
+        {
+            continue;
+        }
+
+        __m256 lifetime = _mm256_sub_ps(old_lifetime, dt);
+        __m256 living = _mm256_and_ps(alive, _mm256_cmp_ps(lifetime, zero, _CMP_GT_OQ));
+        int died_mask = alive_mask & ~_mm256_movemask_ps(living);
+
+        // Every lane holds a valid table index, dead lanes included, so the gathers stay in bounds
+        __m256i table_index = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)&pool->emitter[i]), stride);
+        __m256 gravity = _mm256_i32gather_ps(&emitters->gravity, table_index, 4);
+        __m256 damping = _mm256_sub_ps(one, _mm256_mul_ps(_mm256_i32gather_ps(&emitters->damping, table_index, 4), dt));
+
+        __m256 old_velocity_x = _mm256_loadu_ps(&pool->velocity_x[i]);
+        __m256 old_velocity_y = _mm256_loadu_ps(&pool->velocity_y[i]);
+        __m256 old_position_x = _mm256_loadu_ps(&pool->position_x[i]);
+        __m256 old_position_y = _mm256_loadu_ps(&pool->position_y[i]);
+        __m256 old_alpha = _mm256_loadu_ps(&pool->color_a[i]);
+
+        __m256 velocity_x = _mm256_mul_ps(old_velocity_x, damping);
+        __m256 velocity_y = _mm256_mul_ps(_mm256_add_ps(old_velocity_y, _mm256_mul_ps(gravity, dt)), damping);
+        __m256 position_x = _mm256_add_ps(old_position_x, _mm256_mul_ps(velocity_x, dt));
+        __m256 position_y = _mm256_add_ps(old_position_y, _mm256_mul_ps(velocity_y, dt));
+        __m256 alpha = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(lifetime, quarter), zero), one);
+
+        _mm256_storeu_ps(&pool->velocity_x[i], _mm256_blendv_ps(old_velocity_x, velocity_x, living));
+        _mm256_storeu_ps(&pool->velocity_y[i], _mm256_blendv_ps(old_velocity_y, velocity_y, living));
+        _mm256_storeu_ps(&pool->position_x[i], _mm256_blendv_ps(old_position_x, position_x, living));
+        _mm256_storeu_ps(&pool->position_y[i], _mm256_blendv_ps(old_position_y, position_y, living));
+        _mm256_storeu_ps(&pool->color_a[i], _mm256_blendv_ps(old_alpha, alpha, living));
+        _mm256_storeu_ps(&pool->lifetime[i], _mm256_blendv_ps(old_lifetime, _mm256_and_ps(living, lifetime), alive));
+
+        for (uint32_t lane = 0; lane < 8; lane++)
+        {
+            out_died[died_count] = i + lane;
+            died_count += (died_mask >> lane) & 1;
+        }
+    }
+
+    return died_count + simulate_particles_scalar(pool, emitters, i, end - i, delta_time, out_died + died_count);
+}
+
+#endif
+
+#if defined(PARTICLE_CPU_NEON)
+
+static uint32_t simulate_particles_neon(ParticleCpuPool *pool, const EmitterData *emitters, uint32_t first,
+                                        uint32_t count, float delta_time, uint32_t *out_died)
+{
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    float32x4_t one = vdupq_n_f32(1.0f);
+
+    uint32_t died_count = 0;
+    uint32_t end = first + count;
+    uint32_t i = first;
+    for (; i + 4 <= end; i += 4)
+    {
+        float32x4_t old_lifetime = vld1q_f32(&pool->lifetime[i]);
+        uint32x4_t alive = vcgtq_f32(old_lifetime, zero);
+        if (vmaxvq_u32(alive) == 0)
+        {
+            continue;
+        }
+
+        float32x4_t lifetime = vsubq_f32(old_lifetime, vdupq_n_f32(delta_time));
+        uint32x4_t living = vandq_u32(alive, vcgtq_f32(lifetime, zero));
+
+        // NEON has no gather, emitter settings are loaded lane by lane
+        float gravity_lanes[4];
+        float damping_lanes[4];
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            const EmitterData *emitter = &emitters[pool->emitter[i + lane]];
+            gravity_lanes[lane] = emitter->gravity;
+            damping_lanes[lane] = emitter->damping;
+        }
+        float32x4_t gravity = vld1q_f32(gravity_lanes);
+        float32x4_t damping = vsubq_f32(one, vmulq_n_f32(vld1q_f32(damping_lanes), delta_time));
+
+        float32x4_t old_velocity_x = vld1q_f32(&pool->velocity_x[i]);
+        float32x4_t old_velocity_y = vld1q_f32(&pool->velocity_y[i]);
+        float32x4_t old_position_x = vld1q_f32(&pool->position_x[i]);
+        float32x4_t old_position_y = vld1q_f32(&pool->position_y[i]);
+        float32x4_t old_alpha = vld1q_f32(&pool->color_a[i]);
+
+        float32x4_t velocity_x = vmulq_f32(old_velocity_x, damping);
+        float32x4_t velocity_y = vmulq_f32(vaddq_f32(old_velocity_y, vmulq_n_f32(gravity, delta_time)), damping);
+        float32x4_t position_x = vaddq_f32(old_position_x, vmulq_n_f32(velocity_x, delta_time));
+        float32x4_t position_y = vaddq_f32(old_position_y, vmulq_n_f32(velocity_y, delta_time));
+        float32x4_t alpha = vminq_f32(vmaxq_f32(vmulq_n_f32(lifetime, 0.25f), zero), one);
+
+        vst1q_f32(&pool->velocity_x[i], vbslq_f32(living, velocity_x, old_velocity_x));
+        vst1q_f32(&pool->velocity_y[i], vbslq_f32(living, velocity_y, old_velocity_y));
+        vst1q_f32(&pool->position_x[i], vbslq_f32(living, position_x, old_position_x));
+        vst1q_f32(&pool->position_y[i], vbslq_f32(living, position_y, old_position_y));
+        vst1q_f32(&pool->color_a[i], vbslq_f32(living, alpha, old_alpha));
+        vst1q_f32(&pool->lifetime[i], vbslq_f32(alive, vbslq_f32(living, lifetime, zero), old_lifetime));
+
+        uint32_t died[4];
+        vst1q_u32(died, vbicq_u32(alive, living));
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            out_died[died_count] = i + lane;
+            died_count += died[lane] & 1;
+        }
+    }
+
+    return died_count + simulate_particles_scalar(pool, emitters, i, end - i, delta_time, out_died + died_count);
+}
+
+#endif
+
+ParticleCpuFunctions particle_cpu_select(void)
+{
+    ParticleCpuFunctions functions = { simulate_particles_scalar, "scalar" };
+
+#if defined(PARTICLE_CPU_X86)
+    if (SDL_HasAVX2())
+    {
+        functions.simulate = simulate_particles_avx2;
+        functions.name = "AVX2";
+    }
+    else if (SDL_HasSSE2())
+    {
+        functions.simulate = simulate_particles_sse2;
+        functions.name = "SSE2";
+    }
+#elif defined(PARTICLE_CPU_NEON)
+    if (SDL_HasNEON())
+    {
+        functions.simulate = simulate_particles_neon;
+        functions.name = "NEON";
+    }
+#endif
+
+    return functions;
+}
+
+// Chunks are handed out one at a time, so a thread that falls behind takes fewer of them
+static void particle_cpu_pool_simulate_chunks(ParticleCpuPool *pool)
+{
+    for (;;)
+    {
+        uint32_t chunk = (uint32_t)SDL_AddAtomicInt(&pool->next_chunk, 1);
+        if (chunk >= pool->chunk_count)
+        {
+            break;
+        }
+
+        uint32_t first = chunk * PARTICLE_CPU_CHUNK_SIZE;
+        uint32_t count = pool->particle_count - first;
+        if (count > PARTICLE_CPU_CHUNK_SIZE)
+        {
+            count = PARTICLE_CPU_CHUNK_SIZE;
+        }
+        pool->died_counts[chunk] = pool->functions.simulate(pool, pool->job_emitters, first, count, pool->job_delta_time, &pool->died[first]);
+    }
+}
+
+static int SDLCALL particle_cpu_worker_thread(void *userdata)
+{
+    ParticleCpuPool *pool = (ParticleCpuPool *)userdata;
+    uint32_t generation = 0;
+
+    SDL_LockMutex(pool->mutex);
+    for (;;)
+    {
+        while (pool->running && pool->generation == generation)
+        {
+            SDL_WaitCondition(pool->work_available, pool->mutex);
+        }
+
+        if (!pool->running)
+        {
+            break;
+        }
+
+        generation = pool->generation;
+        SDL_UnlockMutex(pool->mutex);
+
+        particle_cpu_pool_simulate_chunks(pool);
+
+        SDL_LockMutex(pool->mutex);
+        if (--pool->busy_workers == 0)
+        {
+            SDL_SignalCondition(pool->work_done);
+        }
+    }
+    SDL_UnlockMutex(pool->mutex);
+
+    return 0;
+}
+
+bool particle_cpu_pool_create(ParticleCpuPool *pool, uint32_t particle_count, uint32_t thread_count)
+{
+    if (!pool || particle_count == 0)
+    {
+        return false;
+    }
+
+    memset(pool, 0, sizeof(ParticleCpuPool));
+    pool->particle_count = particle_count;
+    pool->chunk_count = (particle_count + PARTICLE_CPU_CHUNK_SIZE - 1) / PARTICLE_CPU_CHUNK_SIZE;
+    pool->functions = particle_cpu_select();
+
+    if (thread_count == 0)
+    {
+        thread_count = (uint32_t)SDL_GetNumLogicalCPUCores();
+    }
+    pool->thread_count = SDL_clamp(thread_count, 1, PARTICLE_CPU_MAX_THREADS);
+
+    // Zeroed slots have no lifetime left and belong to emitter 0
+    float **streams[] = {
+        &pool->position_x, &pool->position_y, &pool->velocity_x, &pool->velocity_y,
+        &pool->color_r, &pool->color_g, &pool->color_b, &pool->color_a, &pool->lifetime, &pool->size
+    };
+    for (uint32_t i = 0; i < SDL_arraysize(streams); i++)
+    {
+        *streams[i] = (float *)calloc(particle_count, sizeof(float));
+        if (!*streams[i])
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate CPU particle streams");
+            particle_cpu_pool_destroy(pool);
+            return false;
+        }
+    }
+
+    pool->emitter = (uint32_t *)calloc(particle_count, sizeof(uint32_t));
+    pool->dead_list = (uint32_t *)malloc(particle_count * sizeof(uint32_t));
+    pool->died = (uint32_t *)malloc(particle_count * sizeof(uint32_t));
+    pool->died_counts = (uint32_t *)calloc(pool->chunk_count, sizeof(uint32_t));
+    if (!pool->emitter || !pool->dead_list || !pool->died || !pool->died_counts)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate CPU particle lists");
+        particle_cpu_pool_destroy(pool);
+        return false;
+    }
+
+    // Same initial stack as the GPU pool, slot 0 is popped first
+    for (uint32_t i = 0; i < particle_count; i++)
+    {
+        pool->dead_list[i] = particle_count - 1 - i;
+    }
+    pool->dead_count = particle_count;
+
+    pool->mutex = SDL_CreateMutex();
+    pool->work_available = SDL_CreateCondition();
+    pool->work_done = SDL_CreateCondition();
+    if (!pool->mutex || !pool->work_available || !pool->work_done)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create CPU particle sync objects: %s", SDL_GetError());
+        particle_cpu_pool_destroy(pool);
+        return false;
+    }
+
+    // More threads than chunks would only ever find the work taken
+    uint32_t worker_count = pool->thread_count < pool->chunk_count ? pool->thread_count - 1 : pool->chunk_count - 1;
+    pool->running = true;
+    for (uint32_t i = 0; i < worker_count; i++)
+    {
+        pool->workers[i] = SDL_CreateThread(particle_cpu_worker_thread, "ParticleWorker", pool);
+        if (!pool->workers[i])
+        {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle worker: %s", SDL_GetError());
+            break;
+        }
+        pool->worker_count++;
+    }
+    pool->thread_count = pool->worker_count + 1;
+
+    SDL_Log("CPU particle pool created with %u particles, %s kernels on up to %u threads",
+            particle_count, pool->functions.name, pool->thread_count);
+    return true;
+}
+
+void particle_cpu_pool_destroy(ParticleCpuPool *pool)
+{
+    if (!pool)
+    {
+        return;
+    }
+
+    if (pool->mutex)
+    {
+        SDL_LockMutex(pool->mutex);
+        pool->running = false;
+        SDL_BroadcastCondition(pool->work_available);
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    for (uint32_t i = 0; i < pool->worker_count; i++)
+    {
+        SDL_WaitThread(pool->workers[i], NULL);
+    }
+
+    if (pool->work_done)
+    {
+        SDL_DestroyCondition(pool->work_done);
+    }
+    if (pool->work_available)
+    {
+        SDL_DestroyCondition(pool->work_available);
+    }
+    if (pool->mutex)
+    {
+        SDL_DestroyMutex(pool->mutex);
+    }
+
+    free(pool->position_x);
+    free(pool->position_y);
+    free(pool->velocity_x);
+    free(pool->velocity_y);
+    free(pool->color_r);
+    free(pool->color_g);
+    free(pool->color_b);
+    free(pool->color_a);
+    free(pool->lifetime);
+    free(pool->size);
+    free(pool->emitter);
+    free(pool->dead_list);
+    free(pool->died);
+    free(pool->died_counts);
+    free(pool->particles);
+    memset(pool, 0, sizeof(ParticleCpuPool));
+}
+
+static void particle_cpu_pool_emit(ParticleCpuPool *pool, const EmitterData *emitters, uint32_t emitter_count, uint32_t spawn_count)
+{
+    // Like the kickoff pass, the spawn budget never takes more slots than are free
+    uint32_t emit_count = spawn_count < pool->dead_count ? spawn_count : pool->dead_count;
+
+    uint32_t emitter_index = 0;
+    for (uint32_t spawn_index = 0; spawn_index < emit_count; spawn_index++)
+    {
+        // Same mapping as find_emitter in particle_emit.comp
+        while (emitter_index + 1 < emitter_count && emitters[emitter_index + 1].spawn_offset <= spawn_index)
+        {
+            emitter_index++;
+        }
+
+        const EmitterData *emitter = &emitters[emitter_index];
+        uint32_t spawn = emitter->spawn_base + (spawn_index - emitter->spawn_offset);
+        float motion[2];
+        float life_red[2];
+        float green_blue[2];
+        float extent[2];
+        particle_random(emitter->seed, spawn, 0, motion);
+        particle_random(emitter->seed, spawn, 1, life_red);
+        particle_random(emitter->seed, spawn, 2, green_blue);
+        particle_random(emitter->seed, spawn, 3, extent);
+
+        uint32_t index = pool->dead_list[--pool->dead_count];
+        float angle = motion[0] * 6.28318530718f;
+        float speed = 2.0f + motion[1] * 3.0f;
+
+        pool->position_x[index] = emitter->position.x;
+        pool->position_y[index] = emitter->position.y;
+        pool->velocity_x[index] = SDL_cosf(angle) * speed;
+        pool->velocity_y[index] = SDL_sinf(angle) * speed;
+        pool->lifetime[index] = 2.0f + life_red[0] * 2.0f;
+        pool->color_r[index] = 0.5f + life_red[1] * 0.5f;
+        pool->color_g[index] = 0.5f + green_blue[0] * 0.5f;
+        pool->color_b[index] = 0.5f + green_blue[1] * 0.5f;
+        pool->color_a[index] = 1.0f;
+        pool->size[index] = 0.05f + extent[0] * 0.05f;
+        pool->emitter[index] = emitter_index;
+    }
+}
+
+void particle_cpu_pool_update(ParticleCpuPool *pool, const EmitterData *emitters, uint32_t emitter_count,
+                              uint32_t spawn_count, float delta_time)
+{
+    if (!pool || !pool->lifetime || !emitters)
+    {
+        return;
+    }
+
+    // Emission is serial and cheap, particles spawned here are simulated in this update like on the GPU
+    particle_cpu_pool_emit(pool, emitters, emitter_count, spawn_count);
+
+    pool->job_emitters = emitters;
+    pool->job_delta_time = delta_time;
+    SDL_SetAtomicInt(&pool->next_chunk, 0);
+
+    // Wake the workers and pull chunks here too, then wait until every worker is done
+    if (pool->worker_count > 0)
+    {
+        SDL_LockMutex(pool->mutex);
+        pool->generation++;
+        pool->busy_workers = pool->worker_count;
+        SDL_BroadcastCondition(pool->work_available);
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    particle_cpu_pool_simulate_chunks(pool);
+
+    if (pool->worker_count > 0)
+    {
+        SDL_LockMutex(pool->mutex);
+        while (pool->busy_workers > 0)
+        {
+            SDL_WaitCondition(pool->work_done, pool->mutex);
+        }
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    // Dead slots go back on the stack in chunk order, which keeps updates deterministic
+    for (uint32_t chunk = 0; chunk < pool->chunk_count; chunk++)
+    {
+        const uint32_t *died = &pool->died[chunk * PARTICLE_CPU_CHUNK_SIZE];
+        for (uint32_t i = 0; i < pool->died_counts[chunk]; i++)
+        {
+            pool->dead_list[pool->dead_count++] = died[i];
+        }
+    }
+}
+
+const Particle *particle_cpu_pool_read(ParticleCpuPool *pool)
+{
+    if (!pool || !pool->lifetime)
+    {
+        return NULL;
+    }
+
+    if (!pool->particles)
+    {
+        pool->particles = (Particle *)calloc(pool->particle_count, sizeof(Particle));
+        if (!pool->particles)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate CPU particle copy");
+            return NULL;
+        }
+    }
+
+    for (uint32_t i = 0; i < pool->particle_count; i++)
+    {
+        Particle *p = &pool->particles[i];
+        p->position = (Vector2f){pool->position_x[i], pool->position_y[i]};
+        p->velocity = (Vector2f){pool->velocity_x[i], pool->velocity_y[i]};
+        p->color = (Vector4f){pool->color_r[i], pool->color_g[i], pool->color_b[i], pool->color_a[i]};
+        p->lifetime = pool->lifetime[i];
+        p->size = pool->size[i];
+        p->emitter = pool->emitter[i];
+    }
+    return pool->particles;
+}
+
+bool particle_cpu_pool_write(ParticleCpuPool *pool, const Particle *particles, uint32_t count)
+{
+    if (!pool || !pool->lifetime || !particles || count != pool->particle_count)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "CPU particle pool write needs all %u particles", pool ? pool->particle_count : 0);
+        return false;
+    }
+
+    pool->dead_count = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t index = count - 1 - i;
+        const Particle *p = &particles[index];
+
+        pool->position_x[index] = p->position.x;
+        pool->position_y[index] = p->position.y;
+        pool->velocity_x[index] = p->velocity.x;
+        pool->velocity_y[index] = p->velocity.y;
+        pool->color_r[index] = p->color.x;
+        pool->color_g[index] = p->color.y;
+        pool->color_b[index] = p->color.z;
+        pool->color_a[index] = p->color.w;
+        pool->lifetime[index] = p->lifetime;
+        pool->size[index] = p->size;
+        pool->emitter[index] = p->emitter;
+
+        // Highest slots go on the stack first so the lowest free slot is popped first
+        if (p->lifetime <= 0.0f)
+        {
+            pool->dead_list[pool->dead_count++] = index;
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef _PARTICLE_CPU_H
+#define _PARTICLE_CPU_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Declared in ParticleSystem.h
+struct Particle;
+struct EmitterData;
+
+// Particles per work item, a multiple of every SIMD width
+#define PARTICLE_CPU_CHUNK_SIZE 4096
+#define PARTICLE_CPU_MAX_THREADS 32
+
+typedef struct ParticleCpuPool ParticleCpuPool;
+
+// Simulates slots first .. first + count - 1 like particles.comp, writes the slots that died
+// to out_died in ascending order and returns how many
+typedef uint32_t (*SimulateParticlesFunc)(ParticleCpuPool *pool, const struct EmitterData *emitters, uint32_t first,
+                                          uint32_t count, float delta_time, uint32_t *out_died);
+
+typedef struct ParticleCpuFunctions
+{
+    SimulateParticlesFunc simulate;
+    const char *name;
+} ParticleCpuFunctions;
+
+// Structure of arrays copy of the GPU pool, slot i of every array is particle i. Dead slots
+// have no lifetime left and sit on the dead list stack like on the GPU
+struct ParticleCpuPool
+{
+    float *position_x;
+    float *position_y;
+    float *velocity_x;
+    float *velocity_y;
+    float *color_r;
+    float *color_g;
+    float *color_b;
+    float *color_a;
+    float *lifetime;
+    float *size;
+    uint32_t *emitter;
+
+    uint32_t *dead_list;
+    uint32_t dead_count;
+
+    // Slots that died in the last update, chunk c writes from slot c * PARTICLE_CPU_CHUNK_SIZE
+    uint32_t *died;
+    uint32_t *died_counts;
+    uint32_t chunk_count;
+
+    // Array of structures copy for read back, allocated on first use
+    struct Particle *particles;
+
+    // Workers live as long as the pool and sleep on work_available between updates. Every
+    // update bumps generation, each worker then pulls chunks once and reports on work_done
+    SDL_Thread *workers[PARTICLE_CPU_MAX_THREADS];
+    uint32_t worker_count;
+    SDL_Mutex *mutex;
+    SDL_Condition *work_available;
+    SDL_Condition *work_done;
+    uint32_t generation;
+    uint32_t busy_workers;
+    bool running;
+
+    // Current update, read by the workers
+    const struct EmitterData *job_emitters;
+    float job_delta_time;
+    SDL_AtomicInt next_chunk;
+
+    ParticleCpuFunctions functions;
+    uint32_t particle_count;
+    uint32_t thread_count; // workers plus the updating thread
+};
+
+// Starts thread_count - 1 workers up front, the updating thread is the last one
+bool particle_cpu_pool_create(ParticleCpuPool *pool, uint32_t particle_count, uint32_t thread_count);
+
+// Stops and joins the workers
+void particle_cpu_pool_destroy(ParticleCpuPool *pool);
+
+// One update with the same rules as the GPU passes: emits min(spawn_count, dead_count) particles
+// over the emitter spawn ranges, then simulates every live slot on up to thread_count threads
+void particle_cpu_pool_update(ParticleCpuPool *pool, const struct EmitterData *emitters, uint32_t emitter_count,
+                              uint32_t spawn_count, float delta_time);
+
+// Same layout as the GPU particle buffer, so both can be diffed slot by slot
+const struct Particle *particle_cpu_pool_read(ParticleCpuPool *pool);
+
+// Replaces the pool with particles, e.g. a GPU readback, slots without lifetime become dead
+bool particle_cpu_pool_write(ParticleCpuPool *pool, const struct Particle *particles, uint32_t count);
+
+// Two uniform floats in [0, 1) for draw pair `draw` of spawn number `spawn` of the emitter with
+// `seed`, from Philox 2x32-10. Must match particle_random in particle_common.glsl bit for bit
+void particle_random(uint32_t seed, uint32_t spawn, uint32_t draw, float out[2]);
+
+// Picks the widest instruction set the CPU supports (AVX2, SSE2 or NEON, else scalar)
+ParticleCpuFunctions particle_cpu_select(void);
+
+#endif
\ No newline at end of file
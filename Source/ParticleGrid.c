@@ -0,0 +1,156 @@
+#include "ParticleGrid.h"
+#include "ParticleSystem.h"
+#include "Shader.h"
+#include <stddef.h>
+
+// Matches GridParams in particle_grid.glsl (std140)
+typedef struct ParticleGridParams
+{
+    float cell_size;
+    float radius;
+    float separation;
+    float cohesion;
+    float alignment;
+    float delta_time;
+    uint32_t cell_count;
+    uint32_t particle_count;
+    uint32_t alive_list;
+    uint32_t max_neighbors;
+    uint32_t padding[2];
+} ParticleGridParams;
+
+static SDL_GPUBuffer *particle_grid_buffer_create(SDL_GPUDevice *device, uint32_t size)
+{
+    SDL_GPUBufferCreateInfo buffer_info = {0};
+    buffer_info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+    buffer_info.size = size;
+
+    SDL_GPUBuffer *buffer = SDL_CreateGPUBuffer(device, &buffer_info);
+    if (!buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle grid buffer: %s", SDL_GetError());
+    }
+    return buffer;
+}
+
+// Survivor passes are sized by the simulate dispatch of the update, the others by group_count
+static bool particle_grid_dispatch_pass(SDL_GPUCommandBuffer *cmd, SDL_GPUComputePipeline *pipeline, SDL_GPUBuffer *const *readonly_buffers,
+                                        uint32_t readonly_count, SDL_GPUBuffer *const *readwrite_buffers, uint32_t readwrite_count,
+                                        const ParticleSystem *system, uint32_t group_count)
+{
+    SDL_GPUBuffer *indirect_buffer = group_count == 0 ? system->indirect_buffer : NULL;
+    return compute_pass_dispatch(cmd, pipeline, readonly_buffers, readonly_count, readwrite_buffers, readwrite_count,
+                                 indirect_buffer, offsetof(ParticleIndirectArgs, simulate_dispatch), group_count);
+}
+
+bool particle_grid_create(ParticleGrid *grid, SDL_GPUDevice *device, uint32_t capacity, uint32_t cell_count, ParticleGridSettings settings)
+{
+    if (!grid || !device || capacity == 0 || cell_count == 0 || cell_count > 0x80000000u || settings.radius <= 0.0f)
+    {
+        return false;
+    }
+
+    SDL_memset(grid, 0, sizeof(ParticleGrid));
+    grid->device = device;
+    grid->settings = settings;
+    grid->capacity = capacity;
+
+    // Power of two, so the hash folds cells into buckets with a mask
+    grid->cell_count = 1;
+    while (grid->cell_count < cell_count)
+    {
+        grid->cell_count <<= 1;
+    }
+
+    grid->cell_count_buffer = particle_grid_buffer_create(device, grid->cell_count * sizeof(uint32_t));
+    grid->cell_start_buffer = particle_grid_buffer_create(device, grid->cell_count * sizeof(uint32_t));
+    grid->particle_cell_buffer = particle_grid_buffer_create(device, capacity * 2 * sizeof(uint32_t));
+    grid->grid_particle_buffer = particle_grid_buffer_create(device, capacity * sizeof(Vector4f));
+    if (!grid->cell_count_buffer || !grid->cell_start_buffer || !grid->particle_cell_buffer || !grid->grid_particle_buffer)
+    {
+        particle_grid_destroy(grid);
+        return false;
+    }
+
+    grid->clear_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_grid_clear.comp.spv", 0, 1, 1, 256);
+    grid->count_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_grid_count.comp.spv", 3, 2, 1, 64);
+    grid->scan_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_grid_scan.comp.spv", 1, 1, 1, 256);
+    grid->scatter_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_grid_scatter.comp.spv", 5, 1, 1, 64);
+    grid->interact_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_grid_interact.comp.spv", 5, 1, 1, 64);
+    if (!grid->clear_pipeline || !grid->count_pipeline || !grid->scan_pipeline || !grid->scatter_pipeline || !grid->interact_pipeline)
+    {
+        particle_grid_destroy(grid);
+        return false;
+    }
+
+    return true;
+}
+
+void particle_grid_destroy(ParticleGrid *grid)
+{
+    if (!grid || !grid->device)
+    {
+        return;
+    }
+
+    SDL_GPUComputePipeline *pipelines[] = {
+        grid->clear_pipeline, grid->count_pipeline, grid->scan_pipeline, grid->scatter_pipeline, grid->interact_pipeline
+    };
+    for (uint32_t i = 0; i < SDL_arraysize(pipelines); i++)
+    {
+        if (pipelines[i])
+        {
+            SDL_ReleaseGPUComputePipeline(grid->device, pipelines[i]);
+        }
+    }
+
+    SDL_GPUBuffer *buffers[] = {
+        grid->cell_count_buffer, grid->cell_start_buffer, grid->particle_cell_buffer, grid->grid_particle_buffer
+    };
+    for (uint32_t i = 0; i < SDL_arraysize(buffers); i++)
+    {
+        if (buffers[i])
+        {
+            SDL_ReleaseGPUBuffer(grid->device, buffers[i]);
+        }
+    }
+
+    SDL_memset(grid, 0, sizeof(ParticleGrid));
+}
+
+bool particle_grid_dispatch(ParticleGrid *grid, SDL_GPUCommandBuffer *cmd, const ParticleSystem *system,
+                            uint32_t alive_list, float delta_time)
+{
+    if (!grid || !grid->interact_pipeline || !cmd || !system || system->particle_count > grid->capacity)
+    {
+        return false;
+    }
+
+    ParticleGridParams params = {0};
+    params.cell_size = grid->settings.radius;
+    params.radius = grid->settings.radius;
+    params.separation = grid->settings.separation;
+    params.cohesion = grid->settings.cohesion;
+    params.alignment = grid->settings.alignment;
+    params.delta_time = delta_time;
+    params.cell_count = grid->cell_count;
+    params.particle_count = system->particle_count;
+    params.alive_list = alive_list;
+    params.max_neighbors = grid->settings.max_neighbors;
+    SDL_PushGPUComputeUniformData(cmd, 0, &params, sizeof(params));
+
+    SDL_GPUBuffer *count_inputs[3] = { system->particle_buffer, system->alive_list_buffer, system->state_buffer };
+    SDL_GPUBuffer *count_outputs[2] = { grid->cell_count_buffer, grid->particle_cell_buffer };
+    SDL_GPUBuffer *scatter_inputs[5] = {
+        system->particle_buffer, system->alive_list_buffer, system->state_buffer, grid->particle_cell_buffer, grid->cell_start_buffer
+    };
+    SDL_GPUBuffer *interact_inputs[5] = {
+        system->alive_list_buffer, system->state_buffer, grid->cell_start_buffer, grid->cell_count_buffer, grid->grid_particle_buffer
+    };
+
+    return particle_grid_dispatch_pass(cmd, grid->clear_pipeline, NULL, 0, &grid->cell_count_buffer, 1, system, (grid->cell_count + 255) / 256) &&
+           particle_grid_dispatch_pass(cmd, grid->count_pipeline, count_inputs, 3, count_outputs, 2, system, 0) &&
+           particle_grid_dispatch_pass(cmd, grid->scan_pipeline, &grid->cell_count_buffer, 1, &grid->cell_start_buffer, 1, system, 1) &&
+           particle_grid_dispatch_pass(cmd, grid->scatter_pipeline, scatter_inputs, 5, &grid->grid_particle_buffer, 1, system, 0) &&
+           particle_grid_dispatch_pass(cmd, grid->interact_pipeline, interact_inputs, 5, &system->particle_buffer, 1, system, 0);
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef _PARTICLE_GRID_H
+#define _PARTICLE_GRID_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Declared in ParticleSystem.h
+struct ParticleSystem;
+
+#define PARTICLE_GRID_DEFAULT_CELLS (64 * 1024)
+#define PARTICLE_GRID_DEFAULT_MAX_NEIGHBORS 32
+
+// Steering weights of the neighbor query, all 0 leaves the particles untouched
+typedef struct ParticleGridSettings
+{
+    float radius;        // also the cell size
+    float separation;    // push away from close neighbors
+    float cohesion;      // pull towards the neighbors' center
+    float alignment;     // match the neighbors' velocity
+    uint32_t max_neighbors;
+} ParticleGridSettings;
+
+// Uniform grid spatial hash over the survivors of every update, rebuilt on the GPU with a
+// counting sort: bucket counts, a prefix sum into bucket starts, then a scatter of position
+// and velocity into bucket order. Neighbor queries only visit the 3x3 cells around a particle,
+// so the interaction pass costs O(n * neighbors) instead of O(n^2)
+typedef struct ParticleGrid
+{
+    SDL_GPUDevice *device;
+    SDL_GPUComputePipeline *clear_pipeline;
+    SDL_GPUComputePipeline *count_pipeline;
+    SDL_GPUComputePipeline *scan_pipeline;
+    SDL_GPUComputePipeline *scatter_pipeline;
+    SDL_GPUComputePipeline *interact_pipeline;
+
+    // Bucket b holds grid_particles[cell_starts[b] .. cell_starts[b] + cell_counts[b] - 1]
+    SDL_GPUBuffer *cell_count_buffer;
+    SDL_GPUBuffer *cell_start_buffer;
+    SDL_GPUBuffer *particle_cell_buffer; // bucket and rank of every survivor
+    SDL_GPUBuffer *grid_particle_buffer; // position and velocity in bucket order
+
+    ParticleGridSettings settings;
+    uint32_t cell_count;
+    uint32_t capacity;
+} ParticleGrid;
+
+// cell_count is rounded up to a power of two, capacity is the particle count of the system
+bool particle_grid_create(ParticleGrid *grid, SDL_GPUDevice *device, uint32_t capacity, uint32_t cell_count, ParticleGridSettings settings);
+void particle_grid_destroy(ParticleGrid *grid);
+
+// Records the grid build over alive list alive_list of system and the interaction pass into
+// cmd, after the update that filled the list. Overwrites compute uniform slot 0
+bool particle_grid_dispatch(ParticleGrid *grid, SDL_GPUCommandBuffer *cmd, const struct ParticleSystem *system,
+                            uint32_t alive_list, float delta_time);
+
+#endif
\ No newline at end of file
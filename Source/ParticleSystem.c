@@ -3,249 +3,582 @@
 #include "Buffers.h"
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 
-bool particle_emitter_create(ParticleEmitter *emitter, SDL_GPUDevice *device, Vector2f position, uint32_t max_particles)
+static SDL_GPUBuffer *particle_buffer_create(SDL_GPUDevice *device, SDL_GPUBufferUsageFlags usage, uint32_t size)
 {
-    if (!emitter || !device || max_particles == 0 || max_particles > MAX_PARTICLES)
+    SDL_GPUBufferCreateInfo buffer_info = {0};
+    buffer_info.usage = usage;
+    buffer_info.size = size;
+    
+    SDL_GPUBuffer *buffer = SDL_CreateGPUBuffer(device, &buffer_info);
+    if (!buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle GPU buffer: %s", SDL_GetError());
+    }
+    return buffer;
+}
+
+static bool particle_system_allocate_emitters(ParticleSystem *system, uint32_t max_emitters)
+{
+    system->emitters = (ParticleEmitter *)calloc(max_emitters, sizeof(ParticleEmitter));
+    system->emitter_table = (EmitterData *)calloc(max_emitters, sizeof(EmitterData));
+    if (!system->emitters || !system->emitter_table)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid particle emitter parameters");
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate particle emitters");
+        free(system->emitters);
+        free(system->emitter_table);
+        memset(system, 0, sizeof(ParticleSystem));
+        return false;
+    }
+    return true;
+}
+
+bool particle_system_create(ParticleSystem *system, SDL_GPUDevice *device, UploadQueue *upload_queue, AsyncUploader *async_uploader,
+                            uint32_t max_particles, uint32_t max_emitters)
+{
+    if (!system || !device || !upload_queue || max_particles == 0 || max_particles > PARTICLE_SYSTEM_MAX_PARTICLES ||
+        max_emitters == 0 || max_emitters > PARTICLE_SYSTEM_MAX_EMITTERS)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid particle system parameters");
         return false;
     }
     
-    memset(emitter, 0, sizeof(ParticleEmitter));
-    emitter->device = device;
-    emitter->particle_count = max_particles;
-    emitter->active = true;
-    
-    // Initialize emitter data
-    emitter->emitter_data.position = position;
-    emitter->emitter_data.particle_count = max_particles;
-    emitter->emitter_data.gravity = -9.8f;
-    emitter->emitter_data.damping = 0.1f;
-    emitter->emitter_data.delta_time = 0.0f;
+    memset(system, 0, sizeof(ParticleSystem));
+    system->device = device;
+    system->upload_queue = upload_queue;
+    system->async_uploader = async_uploader;
+    system->particle_count = max_particles;
+    system->emitter_capacity = max_emitters;
+    system->active = true;
+    system->params.particle_count = max_particles;
     
-    // Allocate CPU-side particle array
-    emitter->particles = (Particle *)calloc(max_particles, sizeof(Particle));
-    if (!emitter->particles)
+    if (!particle_system_allocate_emitters(system, max_emitters))
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate particle memory");
         return false;
     }
     
-    // Initialize particles
-    for (uint32_t i = 0; i < max_particles; i++)
+    SDL_GPUBufferUsageFlags compute_usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;
+    system->particle_buffer = particle_buffer_create(device, compute_usage | SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+                                                     max_particles * sizeof(Particle));
+    system->dead_list_buffer = particle_buffer_create(device, compute_usage, max_particles * sizeof(uint32_t));
+    system->alive_list_buffer = particle_buffer_create(device, compute_usage | SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+                                                       2 * max_particles * sizeof(uint32_t));
+    system->state_buffer = particle_buffer_create(device, compute_usage | SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+                                                  sizeof(ParticlePoolState));
+    system->indirect_buffer = particle_buffer_create(device, SDL_GPU_BUFFERUSAGE_INDIRECT | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE,
+                                                     sizeof(ParticleIndirectArgs));
+    system->emitter_buffer = particle_buffer_create(device, SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ, max_emitters * sizeof(EmitterData));
+    if (!system->particle_buffer || !system->dead_list_buffer || !system->alive_list_buffer ||
+        !system->state_buffer || !system->indirect_buffer || !system->emitter_buffer)
     {
-        emitter->particles[i].position = position;
-        emitter->particles[i].velocity = (Vector2f){0.0f, 0.0f};
-        emitter->particles[i].color = (Vector4f){1.0f, 1.0f, 1.0f, 1.0f};
-        emitter->particles[i].lifetime = 0.0f;
-        emitter->particles[i].size = 0.05f;
+        particle_system_destroy(system);
+        return false;
     }
     
-    // Create GPU particle buffer
-    SDL_GPUBufferCreateInfo particle_buffer_info = {0};
-    particle_buffer_info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;
-    particle_buffer_info.size = max_particles * sizeof(Particle);
+    if (!shadow_buffer_create(&system->emitter_shadow, device, system->emitter_buffer, 0, max_emitters * sizeof(EmitterData)))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create emitter table shadow");
+        particle_system_destroy(system);
+        return false;
+    }
     
-    emitter->particle_buffer = SDL_CreateGPUBuffer(device, &particle_buffer_info);
-    if (!emitter->particle_buffer)
+    // Every slot starts dead, zeroed particles have no lifetime left
+    Particle *particles = (Particle *)calloc(max_particles, sizeof(Particle));
+    uint32_t *dead_list = (uint32_t *)malloc(max_particles * sizeof(uint32_t));
+    ParticlePoolState *state = (ParticlePoolState *)calloc(1, sizeof(ParticlePoolState));
+    if (!particles || !dead_list || !state)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle GPU buffer: %s", SDL_GetError());
-        free(emitter->particles);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate particle pool data");
+        free(particles);
+        free(dead_list);
+        free(state);
+        particle_system_destroy(system);
         return false;
     }
     
-    // Upload initial particle data
-    if (!upload_to_gpu_buffer(device, emitter->particle_buffer, emitter->particles, 
-                               max_particles * sizeof(Particle), 0))
+    for (uint32_t i = 0; i < max_particles; i++)
+    {
+        dead_list[i] = max_particles - 1 - i;
+    }
+    state->dead_count = max_particles;
+    
+    // Stream the initial pool, tickets complete in order so update and render only wait for the last one
+    system->particle_ticket = async_uploader_upload(async_uploader, system->particle_buffer, particles,
+                                                    max_particles * sizeof(Particle), 0, true);
+    if (system->particle_ticket == UPLOAD_TICKET_INVALID)
+    {
+        free(particles);
+    }
+    system->dead_list_ticket = async_uploader_upload(async_uploader, system->dead_list_buffer, dead_list,
+                                                     max_particles * sizeof(uint32_t), 0, true);
+    if (system->dead_list_ticket == UPLOAD_TICKET_INVALID)
+    {
+        free(dead_list);
+    }
+    system->upload_ticket = async_uploader_upload(async_uploader, system->state_buffer, state, sizeof(ParticlePoolState), 0, true);
+    if (system->upload_ticket == UPLOAD_TICKET_INVALID)
+    {
+        free(state);
+    }
+    
+    if (system->particle_ticket == UPLOAD_TICKET_INVALID || system->dead_list_ticket == UPLOAD_TICKET_INVALID ||
+        system->upload_ticket == UPLOAD_TICKET_INVALID)
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload initial particle data");
-        SDL_ReleaseGPUBuffer(device, emitter->particle_buffer);
-        free(emitter->particles);
+        async_uploader_wait(async_uploader, system->particle_ticket > system->dead_list_ticket ? system->particle_ticket : system->dead_list_ticket);
+        particle_system_destroy(system);
         return false;
     }
     
-    // Create emitter buffer (readonly)
-    SDL_GPUBufferCreateInfo emitter_buffer_info = {0};
-    emitter_buffer_info.usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;
-    emitter_buffer_info.size = sizeof(EmitterData);
+    // Kickoff and finish only touch the counters, emit and simulate work on the pool and read the emitter table
+    system->kickoff_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_kickoff.comp.spv", 0, 2, 1, 1);
+    system->emit_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_emit.comp.spv", 1, 4, 1, 64);
+    system->compute_pipeline = compute_pipeline_create(device, "Resources/Shaders/particles.comp.spv", 1, 4, 1, 64);
+    system->finish_pipeline = compute_pipeline_create(device, "Resources/Shaders/particle_finish.comp.spv", 0, 2, 1, 1);
+    if (!system->kickoff_pipeline || !system->emit_pipeline || !system->compute_pipeline || !system->finish_pipeline)
+    {
+        particle_system_destroy(system);
+        return false;
+    }
     
-    emitter->emitter_buffer = SDL_CreateGPUBuffer(device, &emitter_buffer_info);
-    if (!emitter->emitter_buffer)
+    SDL_Log("Particle system created with %u particles and %u emitter slots", max_particles, max_emitters);
+    return true;
+}
+
+bool particle_system_create_cpu(ParticleSystem *system, uint32_t max_particles, uint32_t max_emitters, uint32_t thread_count)
+{
+    if (!system || max_particles == 0 || max_particles > PARTICLE_SYSTEM_MAX_PARTICLES ||
+        max_emitters == 0 || max_emitters > PARTICLE_SYSTEM_MAX_EMITTERS)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create emitter GPU buffer: %s", SDL_GetError());
-        SDL_ReleaseGPUBuffer(device, emitter->particle_buffer);
-        free(emitter->particles);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid particle system parameters");
         return false;
     }
     
-    // Create compute shader
-    ShaderBinary compute_binary = shader_load_from_binary("Resources/Shaders/particles.comp.spv");
+    memset(system, 0, sizeof(ParticleSystem));
+    system->backend = PARTICLE_BACKEND_CPU;
+    system->particle_count = max_particles;
+    system->emitter_capacity = max_emitters;
+    system->active = true;
+    system->params.particle_count = max_particles;
     
-    if (!compute_binary.bytes)
+    if (!particle_system_allocate_emitters(system, max_emitters))
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load particle compute shader");
-        SDL_ReleaseGPUBuffer(device, emitter->particle_buffer);
-        SDL_ReleaseGPUBuffer(device, emitter->emitter_buffer);
-        free(emitter->particles);
         return false;
     }
     
-    // Create compute pipeline
-    SDL_GPUComputePipelineCreateInfo compute_pipeline_info = {0};
-    compute_pipeline_info.code = compute_binary.bytes;
-    compute_pipeline_info.code_size = compute_binary.size;
-    compute_pipeline_info.entrypoint = "main";
-    compute_pipeline_info.format = SDL_GPU_SHADERFORMAT_SPIRV;
-    compute_pipeline_info.num_samplers = 0;
-    compute_pipeline_info.num_readonly_storage_textures = 0;
-    compute_pipeline_info.num_readonly_storage_buffers = 1;    // emitter buffer (binding 0, via SDL_BindGPUComputeStorageBuffers)
-    compute_pipeline_info.num_readwrite_storage_textures = 0;
-    compute_pipeline_info.num_readwrite_storage_buffers = 1;   // particle buffer (binding 0, via SDL_BeginGPUComputePass)
-    compute_pipeline_info.num_uniform_buffers = 0;
-    compute_pipeline_info.threadcount_x = 64;                  // must match shader local_size_x
-    compute_pipeline_info.threadcount_y = 1;
-    compute_pipeline_info.threadcount_z = 1;
-    compute_pipeline_info.props = 0;
-    
-    emitter->compute_pipeline = SDL_CreateGPUComputePipeline(device, &compute_pipeline_info);
-    free(compute_binary.bytes);
-
-    if (!emitter->compute_pipeline)
+    if (!particle_cpu_pool_create(&system->cpu, max_particles, thread_count))
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create compute pipeline: %s", SDL_GetError());
-        SDL_ReleaseGPUBuffer(device, emitter->particle_buffer);
-        SDL_ReleaseGPUBuffer(device, emitter->emitter_buffer);
-        free(emitter->particles);
+        particle_system_destroy(system);
         return false;
     }
     
-    SDL_Log("Particle emitter created with %u particles", max_particles);
+    SDL_Log("CPU particle system created with %u particles and %u emitter slots", max_particles, max_emitters);
     return true;
 }
 
-void particle_emitter_destroy(ParticleEmitter *emitter)
+void particle_system_destroy(ParticleSystem *system)
 {
-    if (!emitter)
+    if (!system || !system->emitters)
     {
         return;
     }
     
-    if (emitter->compute_pipeline)
+    if (system->backend == PARTICLE_BACKEND_CPU)
     {
-        SDL_ReleaseGPUComputePipeline(emitter->device, emitter->compute_pipeline);
-        emitter->compute_pipeline = NULL;
+        particle_cpu_pool_destroy(&system->cpu);
+        free(system->emitters);
+        free(system->emitter_table);
+        memset(system, 0, sizeof(ParticleSystem));
+        return;
     }
     
-    if (emitter->emitter_buffer)
+    SDL_GPUComputePipeline *pipelines[] = {
+        system->kickoff_pipeline, system->emit_pipeline, system->compute_pipeline, system->finish_pipeline,
+        system->sort_keys_pipeline
+    };
+    for (uint32_t i = 0; i < SDL_arraysize(pipelines); i++)
     {
-        SDL_ReleaseGPUBuffer(emitter->device, emitter->emitter_buffer);
-        emitter->emitter_buffer = NULL;
+        if (pipelines[i])
+        {
+            SDL_ReleaseGPUComputePipeline(system->device, pipelines[i]);
+        }
     }
     
-    if (emitter->particle_buffer)
+    gpu_sorter_destroy(&system->sorter);
+    particle_grid_destroy(&system->grid);
+    readback_ring_destroy(&system->readback);
+    shadow_buffer_destroy(&system->emitter_shadow);
+    
+    // In-flight initial uploads still reference the buffers
+    async_uploader_wait(system->async_uploader, system->upload_ticket);
+    
+    SDL_GPUBuffer *buffers[] = {
+        system->particle_buffer, system->dead_list_buffer, system->alive_list_buffer,
+        system->state_buffer, system->indirect_buffer, system->emitter_buffer
+    };
+    for (uint32_t i = 0; i < SDL_arraysize(buffers); i++)
     {
-        SDL_ReleaseGPUBuffer(emitter->device, emitter->particle_buffer);
-        emitter->particle_buffer = NULL;
+        if (buffers[i])
+        {
+            SDL_ReleaseGPUBuffer(system->device, buffers[i]);
+        }
     }
     
-    if (emitter->particles)
+    free(system->emitters);
+    free(system->emitter_table);
+    memset(system, 0, sizeof(ParticleSystem));
+}
+
+ParticleEmitterHandle particle_system_add_emitter(ParticleSystem *system, Vector2f position, float emission_rate)
+{
+    if (!system || !system->emitters)
     {
-        free(emitter->particles);
-        emitter->particles = NULL;
+        return PARTICLE_EMITTER_HANDLE_INVALID;
     }
     
-    emitter->device = NULL;
-    emitter->particle_count = 0;
+    // Reuse the lowest retired slot so the table the GPU searches stays short
+    for (uint32_t i = 0; i < system->emitter_capacity; i++)
+    {
+        ParticleEmitter *emitter = &system->emitters[i];
+        if (emitter->active || emitter->retire_time > system->time)
+        {
+            continue;
+        }
+        
+        memset(emitter, 0, sizeof(ParticleEmitter));
+        emitter->position = position;
+        emitter->gravity = -9.8f;
+        emitter->damping = 0.1f;
+        emitter->emission_rate = emission_rate > 0.0f ? emission_rate : 0.0f;
+        emitter->seed = ++system->emitter_serial;
+        emitter->active = true;
+        
+        if (i >= system->emitter_count)
+        {
+            system->emitter_count = i + 1;
+        }
+        return i + 1;
+    }
+    
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Particle system is out of emitter slots");
+    return PARTICLE_EMITTER_HANDLE_INVALID;
+}
+
+void particle_system_remove_emitter(ParticleSystem *system, ParticleEmitterHandle handle)
+{
+    ParticleEmitter *emitter = particle_system_get_emitter(system, handle);
+    if (!emitter)
+    {
+        return;
+    }
+    
+    // The entry stays in the table until the particles that index it have died
     emitter->active = false;
+    emitter->retire_time = system->time + PARTICLE_MAX_LIFETIME;
 }
 
-void particle_emitter_update(ParticleEmitter *emitter, float delta_time)
+ParticleEmitter *particle_system_get_emitter(ParticleSystem *system, ParticleEmitterHandle handle)
 {
-    if (!emitter || !emitter->active)
+    if (!system || handle == PARTICLE_EMITTER_HANDLE_INVALID || handle > system->emitter_capacity ||
+        !system->emitters[handle - 1].active)
+    {
+        return NULL;
+    }
+    
+    return &system->emitters[handle - 1];
+}
+
+// True once the initial pool is on the GPU. The failures are checked once, when the last ticket
+// completes, since the uploader only remembers the most recent ones. A failed upload leaves the
+// pool buffers undefined, so the system is switched off instead of simulating garbage
+static bool particle_system_uploads_ready(ParticleSystem *system)
+{
+    if (system->uploaded)
+    {
+        return true;
+    }
+    
+    if (!async_uploader_poll(system->async_uploader, system->upload_ticket))
+    {
+        return false;
+    }
+    
+    if (async_uploader_failed(system->async_uploader, system->particle_ticket) ||
+        async_uploader_failed(system->async_uploader, system->dead_list_ticket) ||
+        async_uploader_failed(system->async_uploader, system->upload_ticket))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Initial particle upload failed, particle system disabled");
+        system->active = false;
+        return false;
+    }
+    
+    system->uploaded = true;
+    return true;
+}
+
+void particle_system_update(ParticleSystem *system, float delta_time)
+{
+    if (!system || !system->active)
     {
         return;
     }
     
-    // Update emitter data
-    emitter->emitter_data.delta_time = delta_time;
+    if (system->backend == PARTICLE_BACKEND_CPU)
+    {
+        particle_system_stage_uploads(system, delta_time);
+        particle_system_record_update(system, NULL);
+        return;
+    }
     
-    // Upload emitter data to GPU
-    if (!upload_to_gpu_buffer(emitter->device, emitter->emitter_buffer, &emitter->emitter_data, sizeof(EmitterData), 0))
+    // Initial particle data is still streaming in
+    if (!particle_system_uploads_ready(system))
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload emitter data");
         return;
     }
     
-    // Create command buffer for compute dispatch
-    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(emitter->device);
+    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(system->device);
     if (!cmd)
     {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to acquire command buffer for particle update");
         return;
     }
     
-    // Setup readwrite storage buffer binding for particle buffer
-    SDL_GPUStorageBufferReadWriteBinding readwrite_binding = {0};
-    readwrite_binding.buffer = emitter->particle_buffer;
-    readwrite_binding.cycle = true;
+    // Pending uploads and the emitter table ride along in the same submit, ahead of the dispatch
+    particle_system_stage_uploads(system, delta_time);
+    upload_queue_flush(system->upload_queue, cmd);
+    bool recorded = particle_system_record_update(system, cmd);
     
-    // Begin compute pass with readwrite buffer binding
-    SDL_GPUComputePass *compute_pass = SDL_BeginGPUComputePass(cmd, NULL, 0, &readwrite_binding, 1);
-    if (!compute_pass)
+    SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+    if (!fence)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin compute pass");
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit compute command buffer");
         return;
     }
+    staging_ring_end_frame(system->upload_queue->staging_ring, fence);
+    
+    if (recorded)
+    {
+        particle_system_request_readback(system);
+    }
+}
+
+// Rebuilds the emitter table from the emitter slots and returns this update's spawn budget
+static uint32_t particle_system_build_emitter_table(ParticleSystem *system, float delta_time)
+{
+    // Spawn budgets are whole particles, the remainder carries over to the next update. Each
+    // emitter owns the next spawn_count spawn indices, the emit pass maps indices back to emitters
+    uint32_t spawn_total = 0;
+    for (uint32_t i = 0; i < system->emitter_count; i++)
+    {
+        ParticleEmitter *emitter = &system->emitters[i];
+        uint32_t spawn_count = 0;
+        
+        if (emitter->active)
+        {
+            emitter->spawn_accumulator += emitter->emission_rate * delta_time;
+            if (emitter->spawn_accumulator > (float)system->particle_count)
+            {
+                emitter->spawn_accumulator = (float)system->particle_count;
+            }
+            spawn_count = (uint32_t)emitter->spawn_accumulator;
+            if (spawn_count > system->particle_count - spawn_total)
+            {
+                spawn_count = system->particle_count - spawn_total;
+            }
+            emitter->spawn_accumulator -= (float)spawn_count;
+        }
+        
+        EmitterData *data = &system->emitter_table[i];
+        data->position = emitter->position;
+        data->gravity = emitter->gravity;
+        data->damping = emitter->damping;
+        data->spawn_offset = spawn_total;
+        data->spawn_count = spawn_count;
+        data->seed = emitter->seed;
+        data->spawn_base = emitter->spawned;
+        data->depth = emitter->depth;
+        data->layer = emitter->layer;
+        
+        // Spawns the GPU drops for lack of free slots still use up their numbers
+        emitter->spawned += spawn_count;
+        spawn_total += spawn_count;
+    }
+    return spawn_total;
+}
+
+bool particle_system_stage_uploads(ParticleSystem *system, float delta_time)
+{
+    if (!system || !system->active)
+    {
+        return false;
+    }
     
-    // Bind compute pipeline
-    SDL_BindGPUComputePipeline(compute_pass, emitter->compute_pipeline);
+    // Spawn budgets only advance for updates that will run
+    if (system->backend == PARTICLE_BACKEND_GPU && !particle_system_uploads_ready(system))
+    {
+        return false;
+    }
     
-    // Bind readonly storage buffer (emitter buffer)
-    SDL_GPUBuffer *readonly_buffers[1] = { emitter->emitter_buffer };
-    SDL_BindGPUComputeStorageBuffers(compute_pass, 0, readonly_buffers, 1);
+    // Trailing retired slots drop out of the table, no particle indexes them anymore
+    system->time += delta_time;
+    while (system->emitter_count > 0 && !system->emitters[system->emitter_count - 1].active &&
+           system->emitters[system->emitter_count - 1].retire_time <= system->time)
+    {
+        system->emitter_count--;
+    }
     
-    // Dispatch compute shader (64 threads per workgroup, as defined in shader)
-    uint32_t workgroup_count = (emitter->particle_count + 63) / 64;
-    SDL_DispatchGPUCompute(compute_pass, workgroup_count, 1, 1);
+    system->params.delta_time = delta_time;
+    system->params.emitter_count = system->emitter_count;
+    system->params.spawn_count = particle_system_build_emitter_table(system, delta_time);
     
-    SDL_EndGPUComputePass(compute_pass);
+    if (system->backend == PARTICLE_BACKEND_GPU)
+    {
+        // Only the table bytes that changed are queued, the caller's flush copies them ahead of the passes
+        shadow_buffer_write(&system->emitter_shadow, 0, system->emitter_table, system->emitter_count * sizeof(EmitterData));
+        shadow_buffer_flush(&system->emitter_shadow, system->upload_queue);
+    }
     
-    // Submit command buffer
-    if (!SDL_SubmitGPUCommandBuffer(cmd))
+    system->staged = true;
+    return true;
+}
+
+bool particle_system_record_update(ParticleSystem *system, SDL_GPUCommandBuffer *cmd)
+{
+    if (!system || !system->active || !system->staged)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to submit compute command buffer");
+        return false;
+    }
+    
+    if (system->backend == PARTICLE_BACKEND_CPU)
+    {
+        particle_cpu_pool_update(&system->cpu, system->emitter_table, system->params.emitter_count,
+                                 system->params.spawn_count, system->params.delta_time);
+        system->staged = false;
+        return false;
+    }
+    
+    if (!cmd)
+    {
+        return false;
+    }
+    
+    system->staged = false;
+    system->params.alive_list = system->alive_list;
+    
+    // Parameters go in with the command buffer and stay for all four stages
+    SDL_PushGPUComputeUniformData(cmd, 0, &system->params, sizeof(ParticleSystemParams));
+    
+    // Every stage reads what the previous one or the last update left behind
+    SDL_GPUBuffer *counter_buffers[2] = {system->state_buffer, system->indirect_buffer};
+    SDL_GPUBuffer *pool_buffers[4] = {
+        system->particle_buffer, system->dead_list_buffer, system->alive_list_buffer, system->state_buffer
+    };
+    
+    if (!compute_pass_dispatch(cmd, system->kickoff_pipeline, NULL, 0, counter_buffers, 2, NULL, 0, 1) ||
+        !compute_pass_dispatch(cmd, system->emit_pipeline, &system->emitter_buffer, 1, pool_buffers, 4,
+                               system->indirect_buffer, offsetof(ParticleIndirectArgs, emit_dispatch), 0) ||
+        !compute_pass_dispatch(cmd, system->compute_pipeline, &system->emitter_buffer, 1, pool_buffers, 4,
+                               system->indirect_buffer, offsetof(ParticleIndirectArgs, simulate_dispatch), 0) ||
+        !compute_pass_dispatch(cmd, system->finish_pipeline, NULL, 0, counter_buffers, 2, NULL, 0, 1))
+    {
+        // The pool state may be half updated, keep drawing nothing until an update goes through
+        system->simulated = false;
+        return false;
+    }
+    
+    // A sort that failed to record would leave values[0] holding a stale order, so the
+    // pool is not drawn until the next update sorts it again
+    bool drawable = true;
+    if (system->sorting)
+    {
+        // Keys of the survivors, covered by the simulate dispatch size, then the sort leaves
+        // the back to front draw order in sorter.values[0]
+        SDL_GPUBuffer *key_outputs[2] = {system->sorter.keys[0], system->sorter.values[0]};
+        SDL_GPUBuffer *key_inputs[4] = {
+            system->emitter_buffer, system->particle_buffer, system->alive_list_buffer, system->state_buffer
+        };
+        
+        // The survivor count is alive_count[next], word 0 or 1 of the pool state
+        if (!compute_pass_dispatch(cmd, system->sort_keys_pipeline, key_inputs, 4, key_outputs, 2,
+                                   system->indirect_buffer, offsetof(ParticleIndirectArgs, simulate_dispatch), 0) ||
+            !gpu_sorter_sort(&system->sorter, cmd, system->state_buffer, 1 - system->alive_list))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to record the particle sort");
+            drawable = false;
+        }
+    }
+    
+    // Steers the survivors for the next update, positions and the draw order stay as they are
+    if (system->interacting && !particle_grid_dispatch(&system->grid, cmd, system, 1 - system->alive_list, system->params.delta_time))
+    {
+        // Velocities are only steered, a missed update still leaves a valid pool to draw
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to record the particle grid, interaction disabled");
+        system->interacting = false;
     }
+    
+    system->alive_list = 1 - system->alive_list;
+    system->simulated = drawable;
+    return true;
 }
 
-void particle_emitter_render(ParticleEmitter *emitter, BatchRenderer2D *batch_renderer)
+void particle_system_request_readback(ParticleSystem *system)
 {
-    if (!emitter || !batch_renderer || !emitter->active)
+    if (!system || !system->readback.device)
+    {
+        return;
+    }
+    
+    readback_ring_request(&system->readback, system->particle_buffer, 0, system->particle_count * sizeof(Particle));
+}
+
+void particle_system_render(ParticleSystem *system, BatchRenderer2D *batch_renderer)
+{
+    if (!system || !batch_renderer || !system->active)
+    {
+        return;
+    }
+    
+    if (system->backend == PARTICLE_BACKEND_CPU)
+    {
+        const ParticleCpuPool *pool = &system->cpu;
+        for (uint32_t i = 0; i < pool->particle_count; i++)
+        {
+            if (pool->lifetime[i] > 0.0f)
+            {
+                batch_renderer_2d_add_quad(batch_renderer,
+                                           (Vector2f){pool->position_x[i], pool->position_y[i]},
+                                           (Vector2f){pool->size[i], pool->size[i]},
+                                           (Vector4f){pool->color_r[i], pool->color_g[i], pool->color_b[i], pool->color_a[i]});
+            }
+        }
+        return;
+    }
+    
+    if (!particle_system_uploads_ready(system))
     {
         return;
     }
     
     // Download particle data from GPU to CPU
-    // Note: In a real implementation, you might want to use a readback buffer
-    // For now, we'll use a simple approach
     SDL_GPUTransferBufferCreateInfo transfer_info = {0};
     transfer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
-    transfer_info.size = emitter->particle_count * sizeof(Particle);
+    transfer_info.size = system->particle_count * sizeof(Particle);
     
-    SDL_GPUTransferBuffer *download_buffer = SDL_CreateGPUTransferBuffer(emitter->device, &transfer_info);
+    SDL_GPUTransferBuffer *download_buffer = SDL_CreateGPUTransferBuffer(system->device, &transfer_info);
     if (!download_buffer)
     {
         return;
     }
     
     // Create download command
-    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(emitter->device);
+    SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(system->device);
     SDL_GPUCopyPass *copy_pass = SDL_BeginGPUCopyPass(cmd);
     
     SDL_GPUBufferRegion src_region = {0};
-    src_region.buffer = emitter->particle_buffer;
+    src_region.buffer = system->particle_buffer;
     src_region.offset = 0;
-    src_region.size = emitter->particle_count * sizeof(Particle);
+    src_region.size = system->particle_count * sizeof(Particle);
     
     SDL_GPUTransferBufferLocation dst_location = {0};
     dst_location.transfer_buffer = download_buffer;
@@ -256,19 +589,15 @@ void particle_emitter_render(ParticleEmitter *emitter, BatchRenderer2D *batch_re
     SDL_SubmitGPUCommandBuffer(cmd);
     
     // Wait for transfer to complete (blocking, but ensures we have the data)
-    SDL_WaitForGPUIdle(emitter->device);
+    SDL_WaitForGPUIdle(system->device);
     
-    // Map and read particle data
-    void *mapped_data = SDL_MapGPUTransferBuffer(emitter->device, download_buffer, false);
-    if (mapped_data)
+    // Read straight from the mapping and add the live particles to the batch
+    const Particle *particles = (const Particle *)SDL_MapGPUTransferBuffer(system->device, download_buffer, false);
+    if (particles)
     {
-        memcpy(emitter->particles, mapped_data, emitter->particle_count * sizeof(Particle));
-        SDL_UnmapGPUTransferBuffer(emitter->device, download_buffer);
-        
-        // Add particles to batch renderer
-        for (uint32_t i = 0; i < emitter->particle_count; i++)
+        for (uint32_t i = 0; i < system->particle_count; i++)
         {
-            Particle *p = &emitter->particles[i];
+            const Particle *p = &particles[i];
             
             // Only render alive particles
             if (p->lifetime > 0.0f)
@@ -279,16 +608,205 @@ void particle_emitter_render(ParticleEmitter *emitter, BatchRenderer2D *batch_re
                                            p->color);
             }
         }
+        SDL_UnmapGPUTransferBuffer(system->device, download_buffer);
     }
     
-    SDL_ReleaseGPUTransferBuffer(emitter->device, download_buffer);
+    SDL_ReleaseGPUTransferBuffer(system->device, download_buffer);
+}
+
+bool particle_system_enable_readback(ParticleSystem *system, uint32_t frame_count)
+{
+    if (system && system->backend == PARTICLE_BACKEND_CPU)
+    {
+        return true;
+    }
+    
+    if (!system || !system->device)
+    {
+        return false;
+    }
+    
+    if (system->readback.device)
+    {
+        return true;
+    }
+    
+    if (!readback_ring_create(&system->readback, system->device, system->particle_count * sizeof(Particle), frame_count))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle readback ring");
+        return false;
+    }
+    
+    return true;
+}
+
+const Particle *particle_system_read_particles(ParticleSystem *system, uint32_t *out_count, uint64_t *out_latency)
+{
+    if (system && system->backend == PARTICLE_BACKEND_CPU)
+    {
+        const Particle *particles = particle_cpu_pool_read(&system->cpu);
+        if (particles && out_count)
+        {
+            *out_count = system->particle_count;
+        }
+        if (particles && out_latency)
+        {
+            *out_latency = 0;
+        }
+        return particles;
+    }
+    
+    if (!system || !system->readback.device)
+    {
+        return NULL;
+    }
+    
+    readback_ring_poll(&system->readback);
+    if (system->readback.data_frame == 0)
+    {
+        return NULL;
+    }
+    
+    if (out_count)
+    {
+        *out_count = system->readback.data_size / sizeof(Particle);
+    }
+    if (out_latency)
+    {
+        *out_latency = readback_ring_latency(&system->readback);
+    }
+    return (const Particle *)system->readback.data;
+}
+
+bool particle_system_write_particles(ParticleSystem *system, const Particle *particles, uint32_t count)
+{
+    if (!system || system->backend != PARTICLE_BACKEND_CPU)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Only the CPU particle backend can be written to");
+        return false;
+    }
+    
+    return particle_cpu_pool_write(&system->cpu, particles, count);
+}
+
+SDL_GPUGraphicsPipeline *particle_render_pipeline_create(SDL_GPUDevice *device, SDL_GPUTextureFormat format, bool sorted)
+{
+    const char *vertex_path = sorted ? "Resources/Shaders/particle_sorted.vert.spv" : "Resources/Shaders/particle.vert.spv";
+    Shader vertex_shader = shader_create(device, SDL_GPU_SHADERSTAGE_VERTEX, vertex_path, "main");
+    Shader fragment_shader = shader_create(device, SDL_GPU_SHADERSTAGE_FRAGMENT, "Resources/Shaders/2d.frag.spv", "main");
+    
+    SDL_GPUGraphicsPipeline *pipeline = NULL;
+    if (vertex_shader.handle && fragment_shader.handle)
+    {
+        // No vertex buffers, everything is pulled from storage
+        GraphicsPipelineDescription desc = {0};
+        desc.primitive_type = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+        desc.front_face = SDL_GPU_FRONTFACE_COUNTER_CLOCKWISE;
+        desc.format = format;
+        desc.fill_mode = SDL_GPU_FILLMODE_FILL;
+        desc.cull_mode = SDL_GPU_CULLMODE_NONE;
+        desc.compare_op = SDL_GPU_COMPAREOP_ALWAYS;
+        desc.vertex_shader = vertex_shader.handle;
+        desc.fragment_shader = fragment_shader.handle;
+        desc.enable_depth_test = false;
+        desc.enable_depth_write = false;
+        desc.enable_blend = sorted; // unsorted overlap order changes every frame
+        
+        pipeline = graphics_pipeline_create(device, &desc);
+    }
+    
+    if (!pipeline)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle render pipeline");
+    }
+    shader_release(device, &vertex_shader);
+    shader_release(device, &fragment_shader);
+    
+    return pipeline;
+}
+
+void particle_system_draw(ParticleSystem *system, SDL_GPURenderPass *render_pass, SDL_GPUGraphicsPipeline *pipeline)
+{
+    // The draw arguments only exist once an update has run
+    if (!system || !system->active || !system->simulated || !render_pass || !pipeline)
+    {
+        return;
+    }
+    
+    SDL_GPUBuffer *storage_buffers[3] = { system->particle_buffer, system->alive_list_buffer, system->state_buffer };
+    uint32_t storage_buffer_count = 3;
+    if (system->sorting)
+    {
+        // particle_sorted.vert reads the order straight from the sort output
+        storage_buffers[1] = system->sorter.values[0];
+        storage_buffer_count = 2;
+    }
+    
+    SDL_BindGPUGraphicsPipeline(render_pass, pipeline);
+    SDL_BindGPUVertexStorageBuffers(render_pass, 1, storage_buffers, storage_buffer_count);
+    SDL_DrawGPUPrimitivesIndirect(render_pass, system->indirect_buffer, offsetof(ParticleIndirectArgs, draw), 1);
+}
+
+bool particle_system_enable_sorting(ParticleSystem *system)
+{
+    if (!system || system->backend != PARTICLE_BACKEND_GPU || !system->device)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Only the GPU particle backend can sort");
+        return false;
+    }
+    
+    if (system->sorting)
+    {
+        return true;
+    }
+    
+    if (!gpu_sorter_create(&system->sorter, system->device, system->particle_count))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle sorter");
+        return false;
+    }
+    
+    system->sort_keys_pipeline = compute_pipeline_create(system->device, "Resources/Shaders/particle_sort_keys.comp.spv", 4, 2, 1, 64);
+    if (!system->sort_keys_pipeline)
+    {
+        gpu_sorter_destroy(&system->sorter);
+        return false;
+    }
+    
+    // The sorted order is only written by the next update
+    system->sorting = true;
+    system->simulated = false;
+    return true;
+}
+
+bool particle_system_enable_interaction(ParticleSystem *system, uint32_t cell_count, ParticleGridSettings settings)
+{
+    if (!system || system->backend != PARTICLE_BACKEND_GPU || !system->device)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Only the GPU particle backend supports interaction");
+        return false;
+    }
+    
+    // Recreated so new settings or cell counts take effect
+    particle_grid_destroy(&system->grid);
+    system->interacting = false;
+    
+    if (!particle_grid_create(&system->grid, system->device, system->particle_count,
+                              cell_count ? cell_count : PARTICLE_GRID_DEFAULT_CELLS, settings))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create particle grid");
+        return false;
+    }
+    
+    system->interacting = true;
+    return true;
 }
 
 void particle_emitter_set_position(ParticleEmitter *emitter, Vector2f position)
 {
     if (emitter)
     {
-        emitter->emitter_data.position = position;
+        emitter->position = position;
     }
 }
 
@@ -296,7 +814,7 @@ void particle_emitter_set_gravity(ParticleEmitter *emitter, float gravity)
 {
     if (emitter)
     {
-        emitter->emitter_data.gravity = gravity;
+        emitter->gravity = gravity;
     }
 }
 
@@ -304,6 +822,40 @@ void particle_emitter_set_damping(ParticleEmitter *emitter, float damping)
 {
     if (emitter)
     {
-        emitter->emitter_data.damping = damping;
+        emitter->damping = damping;
+    }
+}
+
+void particle_emitter_set_emission_rate(ParticleEmitter *emitter, float emission_rate)
+{
+    if (emitter)
+    {
+        emitter->emission_rate = emission_rate > 0.0f ? emission_rate : 0.0f;
+    }
+}
+
+void particle_emitter_set_seed(ParticleEmitter *emitter, uint32_t seed)
+{
+    if (emitter)
+    {
+        emitter->seed = seed;
+        emitter->spawned = 0;
+        emitter->spawn_accumulator = 0.0f;
+    }
+}
+
+void particle_emitter_set_depth(ParticleEmitter *emitter, float depth)
+{
+    if (emitter)
+    {
+        emitter->depth = SDL_clamp(depth, 0.0f, 1.0f);
+    }
+}
+
+void particle_emitter_set_layer(ParticleEmitter *emitter, uint32_t layer)
+{
+    if (emitter)
+    {
+        emitter->layer = layer < PARTICLE_SORT_LAYERS ? layer : PARTICLE_SORT_LAYERS - 1;
     }
 }
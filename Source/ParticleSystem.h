@@ -6,8 +6,23 @@
 #include <stdbool.h>
 #include "Math.h"
 #include "Renderer.h"
+#include "Buffers.h"
+#include "AsyncUploader.h"
+#include "GraphicsPipeline.h"
+#include "ParticleCpu.h"
+#include "GpuSort.h"
+#include "ParticleGrid.h"
 
-#define MAX_PARTICLES 10000
+// Pool and emitter table limits, the pool is shared by every emitter of a system
+#define PARTICLE_SYSTEM_MAX_PARTICLES (16 * 1024 * 1024)
+#define PARTICLE_SYSTEM_MAX_EMITTERS 4096
+
+// Spawned particles live 2 to 4 seconds
+#define PARTICLE_AVERAGE_LIFETIME 3.0f
+#define PARTICLE_MAX_LIFETIME 4.0f
+
+// Draw order layers, 4 bits of the sort key (see particle_sort_keys.comp)
+#define PARTICLE_SORT_LAYERS 16
 
 // Particle structure (must match compute shader layout)
 typedef struct Particle
@@ -17,41 +32,224 @@ typedef struct Particle
     Vector4f color;
     float lifetime;
     float size;
-    float padding[2];
+    uint32_t emitter; // index of the emitter table entry that spawned it
+    float padding;
 } Particle;
 
-// Emitter data (must match compute shader uniform layout)
+// Emitter table entry, rebuilt every update (must match particle_common.glsl, std430)
 typedef struct EmitterData
 {
     Vector2f position;
-    float delta_time;
-    uint32_t particle_count;
     float gravity;
     float damping;
-    float padding[2];
+    uint32_t spawn_offset; // first spawn index of this emitter, spawn ranges follow table order
+    uint32_t spawn_count;
+    uint32_t seed;
+    uint32_t spawn_base;   // particles the emitter spawned before this update
+    float depth;
+    uint32_t layer;
 } EmitterData;
 
-// Particle emitter
+// Per update parameters, pushed as the compute uniform (must match particle_common.glsl, std140)
+typedef struct ParticleSystemParams
+{
+    float delta_time;
+    uint32_t particle_count;
+    uint32_t emitter_count;
+    uint32_t spawn_count; // particles to emit over all emitters, clamped to the free slots on the GPU
+    uint32_t alive_list;  // alive list simulated this update, 0 or 1
+    uint32_t padding[3];
+} ParticleSystemParams;
+
+// Pool counters on the GPU (must match particle_common.glsl)
+typedef struct ParticlePoolState
+{
+    uint32_t alive_count[2];
+    uint32_t dead_count;
+    uint32_t emit_count;
+    uint32_t draw_list_offset;
+    uint32_t padding[3];
+} ParticlePoolState;
+
+// Written by the kickoff and finish passes, consumed by indirect dispatches and the draw
+typedef struct ParticleIndirectArgs
+{
+    SDL_GPUIndirectDispatchCommand emit_dispatch;
+    SDL_GPUIndirectDispatchCommand simulate_dispatch;
+    SDL_GPUIndirectDrawCommand draw;
+} ParticleIndirectArgs;
+
+// CPU side of an emitter, copied into the emitter table on every update
 typedef struct ParticleEmitter
 {
+    Vector2f position;
+    float gravity;
+    float damping;
+    float emission_rate;
+    float spawn_accumulator;
+    
+    // Spawn n of the emitter always draws the same random values from seed, on either backend
+    uint32_t seed;
+    uint32_t spawned;
+    
+    // Sorted draws go back to front: ascending layer, then depth from 1 (back) to 0 (front)
+    float depth;
+    uint32_t layer;
+    bool active;
+    
+    // System time once every particle of a removed emitter is dead. Live particles index the
+    // table by slot, so the slot is not handed out again before then
+    double retire_time;
+} ParticleEmitter;
+
+// GPU runs the compute passes, CPU runs the same rules in ParticleCpu for machines without compute
+typedef enum ParticleBackend
+{
+    PARTICLE_BACKEND_GPU,
+    PARTICLE_BACKEND_CPU
+} ParticleBackend;
+
+// Handles are table index + 1, 0 is never a valid handle
+typedef uint32_t ParticleEmitterHandle;
+#define PARTICLE_EMITTER_HANDLE_INVALID 0
+
+// Every emitter shares one particle pool. Free slots sit on a dead list stack and live ones on
+// an alive list, particles carry the index of their emitter, and one set of dispatches and one
+// draw cover all emitters, so pipelines, buffers and submits do not grow with the emitter count
+typedef struct ParticleSystem
+{
+    ParticleBackend backend;
     SDL_GPUDevice *device;
+    UploadQueue *upload_queue;
+    AsyncUploader *async_uploader;
+    UploadTicket particle_ticket;
+    UploadTicket dead_list_ticket;
+    UploadTicket upload_ticket; // pool state, the last initial upload to complete
+    bool uploaded;              // every initial upload completed without failing
+    SDL_GPUComputePipeline *kickoff_pipeline;
+    SDL_GPUComputePipeline *emit_pipeline;
     SDL_GPUComputePipeline *compute_pipeline;
+    SDL_GPUComputePipeline *finish_pipeline;
     SDL_GPUBuffer *particle_buffer;
+    SDL_GPUBuffer *dead_list_buffer;
+    SDL_GPUBuffer *alive_list_buffer; // two lists of particle_count indices, swapped every update
+    SDL_GPUBuffer *state_buffer;
+    SDL_GPUBuffer *indirect_buffer;
     SDL_GPUBuffer *emitter_buffer;
+    uint32_t alive_list;
+    bool staged; // the emitter table and params of the next update are ready
+    bool simulated;
+    
+    // Emitter slots, emitter_count is one past the highest slot that is active or still has
+    // particles alive. The table is rebuilt from the slots every update and mirrored to the
+    // GPU through the shadow
+    ParticleEmitter *emitters;
+    EmitterData *emitter_table;
+    ShadowBuffer emitter_shadow;
+    uint32_t emitter_capacity;
+    uint32_t emitter_count;
+    uint32_t emitter_serial; // seeds new emitters, so the same sequence of adds gives the same seeds
+    double time;             // seconds simulated so far, removed emitters retire against it
     
-    Particle *particles;
-    EmitterData emitter_data;
+    ParticleSystemParams params;
+    
+    // Optional back to front order of the survivors, rebuilt on the GPU after every update
+    GpuSorter sorter;
+    SDL_GPUComputePipeline *sort_keys_pipeline;
+    bool sorting;
+    
+    // Optional neighbor interaction over a spatial hash of the survivors, after every update
+    ParticleGrid grid;
+    bool interacting;
+    
+    // Optional latent CPU copy of the particles, device is NULL while disabled
+    ReadbackRing readback;
+    
+    // Pool of the CPU backend
+    ParticleCpuPool cpu;
     
     uint32_t particle_count;
     bool active;
-} ParticleEmitter;
+} ParticleSystem;
+
+bool particle_system_create(ParticleSystem *system, SDL_GPUDevice *device, UploadQueue *upload_queue, AsyncUploader *async_uploader,
+                            uint32_t max_particles, uint32_t max_emitters);
+
+// Same system without a GPU, thread_count 0 uses every logical core. Update and render as usual,
+// particle_system_draw draws nothing and particle_system_render adds the particles to a batch
+bool particle_system_create_cpu(ParticleSystem *system, uint32_t max_particles, uint32_t max_emitters, uint32_t thread_count);
+void particle_system_destroy(ParticleSystem *system);
+
+// Emitters start with gravity -9.8 and damping 0.1, emission_rate is in particles per second
+ParticleEmitterHandle particle_system_add_emitter(ParticleSystem *system, Vector2f position, float emission_rate);
+
+// Stops spawning right away, particles already alive finish their lifetime with the removed
+// emitter's settings. The slot is reused once they are all dead
+void particle_system_remove_emitter(ParticleSystem *system, ParticleEmitterHandle handle);
+
+// The emitter stays valid until it is removed, changes reach the GPU with the next update
+ParticleEmitter *particle_system_get_emitter(ParticleSystem *system, ParticleEmitterHandle handle);
+
+// Standalone update: flushes pending uploads and dispatches in its own submit
+void particle_system_update(ParticleSystem *system, float delta_time);
+
+// Builds the emitter table of the next update and queues the bytes that changed on the upload
+// queue, so they go out with the caller's single upload_queue_flush. Returns false while the
+// initial pool is still streaming in, nothing is staged then
+bool particle_system_stage_uploads(ParticleSystem *system, float delta_time);
+
+// Records the simulation staged by particle_system_stage_uploads into cmd (outside of any pass),
+// after the upload queue flush. Returns false when nothing was recorded, the CPU backend
+// simulates right away instead
+bool particle_system_record_update(ParticleSystem *system, SDL_GPUCommandBuffer *cmd);
+
+// Queues the readback of the latest update, call it once the update's command buffer is submitted
+void particle_system_request_readback(ParticleSystem *system);
+
+// Reads every particle back and adds the live ones to the batch. Waits for the GPU to go
+// idle, particle_system_draw renders without leaving the GPU. The CPU backend reads its pool
+void particle_system_render(ParticleSystem *system, BatchRenderer2D *batch_renderer);
+
+// Pipeline for particle_system_draw, quads are expanded from particle_buffer in particle.vert.
+// Sorted pipelines read the sorted order and alpha blend, use them once sorting is enabled
+SDL_GPUGraphicsPipeline *particle_render_pipeline_create(SDL_GPUDevice *device, SDL_GPUTextureFormat format, bool sorted);
+
+// Draws the live particles of every emitter straight from the GPU buffers with the count the
+// last update left in the indirect arguments. The caller binds the view-projection buffer to
+// vertex storage slot 0
+void particle_system_draw(ParticleSystem *system, SDL_GPURenderPass *render_pass, SDL_GPUGraphicsPipeline *pipeline);
+
+// GPU backend only: sorts the survivors of every update by emitter layer, depth and age so
+// blended draws come out back to front. Costs a radix sort of the live count per update
+bool particle_system_enable_sorting(ParticleSystem *system);
+
+// GPU backend only: steers every survivor by its neighbors within settings.radius after each
+// update (separation, cohesion and alignment). cell_count 0 uses PARTICLE_GRID_DEFAULT_CELLS
+bool particle_system_enable_interaction(ParticleSystem *system, uint32_t cell_count, ParticleGridSettings settings);
+
+// Downloads the particles after every update through a ring of frame_count buffers
+bool particle_system_enable_readback(ParticleSystem *system, uint32_t frame_count);
+
+// Newest particle copy that has reached the CPU, NULL until the first one lands. Never waits,
+// out_latency is how many updates behind the GPU the copy is. The CPU backend needs no
+// readback, its copy is always current
+const Particle *particle_system_read_particles(ParticleSystem *system, uint32_t *out_count, uint64_t *out_latency);
+
+// CPU backend only: replaces the pool, e.g. with a GPU readback to diff the next update against
+bool particle_system_write_particles(ParticleSystem *system, const Particle *particles, uint32_t count);
 
-bool particle_emitter_create(ParticleEmitter *emitter, SDL_GPUDevice *device, Vector2f position, uint32_t max_particles);
-void particle_emitter_destroy(ParticleEmitter *emitter);
-void particle_emitter_update(ParticleEmitter *emitter, float delta_time);
-void particle_emitter_render(ParticleEmitter *emitter, BatchRenderer2D *batch_renderer);
 void particle_emitter_set_position(ParticleEmitter *emitter, Vector2f position);
 void particle_emitter_set_gravity(ParticleEmitter *emitter, float gravity);
 void particle_emitter_set_damping(ParticleEmitter *emitter, float damping);
 
+// Particles per second, fractions carry over between updates
+void particle_emitter_set_emission_rate(ParticleEmitter *emitter, float emission_rate);
+
+// Restarts the emitter's random sequence, replaying the same updates gives the same particles
+void particle_emitter_set_seed(ParticleEmitter *emitter, uint32_t seed);
+
+// Draw order of sorted systems, depth is clamped to [0, 1] and layer to PARTICLE_SORT_LAYERS - 1
+void particle_emitter_set_depth(ParticleEmitter *emitter, float depth);
+void particle_emitter_set_layer(ParticleEmitter *emitter, uint32_t layer);
+
 #endif
@@ -0,0 +1,344 @@
+#include "QuadPack.h"
+#include "Renderer.h"
+
+#include <SDL3/SDL_cpuinfo.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define QUAD_PACK_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define QUAD_PACK_NEON 1
+#include <arm_neon.h>
+#endif
+
+// MSVC compiles intrinsics for any target, GCC and Clang need them enabled per function
+#if defined(QUAD_PACK_X86) && (defined(__GNUC__) || defined(__clang__))
+#define QUAD_PACK_TARGET_AVX2 __attribute__((target("avx2")))
+#define QUAD_PACK_TARGET_AVX2_F16C __attribute__((target("avx2,f16c")))
+#else
+#define QUAD_PACK_TARGET_AVX2
+#define QUAD_PACK_TARGET_AVX2_F16C
+#endif
+
+static void pack_colors_scalar(const Vector4f *colors, uint32_t *out_colors, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        out_colors[i] = pack_color_rgba8(colors[i]);
+    }
+}
+
+static void pack_halves_scalar(const float *values, uint16_t *out_halves, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        out_halves[i] = pack_half(values[i]);
+    }
+}
+
+bool quad_is_visible(Vector2f position, Vector2f size, Rect2f bounds)
+{
+    float half_x = size.x * 0.5f;
+    float half_y = size.y * 0.5f;
+    return position.x - half_x <= bounds.max.x && position.x + half_x >= bounds.min.x &&
+           position.y - half_y <= bounds.max.y && position.y + half_y >= bounds.min.y;
+}
+
+static uint32_t cull_quads_scalar(const Vector2f *positions, const Vector2f *sizes, uint32_t count,
+                                  Rect2f bounds, uint32_t *out_visible)
+{
+    uint32_t visible_count = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        out_visible[visible_count] = i;
+        visible_count += quad_is_visible(positions[i], sizes[i], bounds);
+    }
+    return visible_count;
+}
+
+#if defined(QUAD_PACK_X86)
+
+static __m128i pack_color_sse2(const Vector4f *color)
+{
+    __m128 value = _mm_loadu_ps(&color->x);
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    value = _mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+    return _mm_cvttps_epi32(value);
+}
+
+static void pack_colors_sse2(const Vector4f *colors, uint32_t *out_colors, uint32_t count)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Saturating packs narrow 4 x RGBA int32 down to 4 x RGBA8, red stays in the low byte
+        __m128i c01 = _mm_packs_epi32(pack_color_sse2(&colors[i + 0]), pack_color_sse2(&colors[i + 1]));
+        __m128i c23 = _mm_packs_epi32(pack_color_sse2(&colors[i + 2]), pack_color_sse2(&colors[i + 3]));
+        _mm_storeu_si128((__m128i *)&out_colors[i], _mm_packus_epi16(c01, c23));
+    }
+
+    pack_colors_scalar(colors + i, out_colors + i, count - i);
+}
+
+static uint32_t cull_quads_sse2(const Vector2f *positions, const Vector2f *sizes, uint32_t count,
+                                Rect2f bounds, uint32_t *out_visible)
+{
+    __m128 min_x = _mm_set1_ps(bounds.min.x);
+    __m128 min_y = _mm_set1_ps(bounds.min.y);
+    __m128 max_x = _mm_set1_ps(bounds.max.x);
+    __m128 max_y = _mm_set1_ps(bounds.max.y);
+    __m128 half = _mm_set1_ps(0.5f);
+
+    uint32_t visible_count = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // Split interleaved xy pairs into x and y lanes
+        __m128 p01 = _mm_loadu_ps(&positions[i].x);
+        __m128 p23 = _mm_loadu_ps(&positions[i + 2].x);
+        __m128 s01 = _mm_loadu_ps(&sizes[i].x);
+        __m128 s23 = _mm_loadu_ps(&sizes[i + 2].x);
+
+        __m128 px = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 py = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 hx = _mm_mul_ps(_mm_shuffle_ps(s01, s23, _MM_SHUFFLE(2, 0, 2, 0)), half);
+        __m128 hy = _mm_mul_ps(_mm_shuffle_ps(s01, s23, _MM_SHUFFLE(3, 1, 3, 1)), half);
+
+        __m128 visible = _mm_and_ps(
+            _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(px, hx), max_x), _mm_cmpge_ps(_mm_add_ps(px, hx), min_x)),
+            _mm_and_ps(_mm_cmple_ps(_mm_sub_ps(py, hy), max_y), _mm_cmpge_ps(_mm_add_ps(py, hy), min_y)));
+        int mask = _mm_movemask_ps(visible);
+
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            out_visible[visible_count] = i + lane;
+            visible_count += (mask >> lane) & 1;
+        }
+    }
+
+    uint32_t tail_count = cull_quads_scalar(positions + i, sizes + i, count - i, bounds, out_visible + visible_count);
+    for (uint32_t t = 0; t < tail_count; t++)
+    {
+        out_visible[visible_count + t] += i;
+    }
+    return visible_count + tail_count;
+}
+
+QUAD_PACK_TARGET_AVX2
+static __m256i pack_color_pair_avx2(const Vector4f *colors)
+{
+    __m256 value = _mm256_loadu_ps(&colors->x);
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    value = _mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f));
+    return _mm256_cvttps_epi32(value);
+}
+
+QUAD_PACK_TARGET_AVX2
+static void pack_colors_avx2(const Vector4f *colors, uint32_t *out_colors, uint32_t count)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // Packs work per 128-bit lane, leaving colors in 0 2 4 6 | 1 3 5 7 order
+        __m256i c0246_1357 = _mm256_packus_epi16(
+            _mm256_packs_epi32(pack_color_pair_avx2(&colors[i + 0]), pack_color_pair_avx2(&colors[i + 2])),
+            _mm256_packs_epi32(pack_color_pair_avx2(&colors[i + 4]), pack_color_pair_avx2(&colors[i + 6])));
+        __m256i ordered = _mm256_permutevar8x32_epi32(c0246_1357, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+        _mm256_storeu_si256((__m256i *)&out_colors[i], ordered);
+    }
+
+    pack_colors_sse2(colors + i, out_colors + i, count - i);
+}
+
+QUAD_PACK_TARGET_AVX2_F16C
+static void pack_halves_avx2(const float *values, uint16_t *out_halves, uint32_t count)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i halves = _mm256_cvtps_ph(_mm256_loadu_ps(&values[i]), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128((__m128i *)&out_halves[i], halves);
+    }
+
+    pack_halves_scalar(values + i, out_halves + i, count - i);
+}
+
+QUAD_PACK_TARGET_AVX2
+static uint32_t cull_quads_avx2(const Vector2f *positions, const Vector2f *sizes, uint32_t count,
+                                Rect2f bounds, uint32_t *out_visible)
+{
+    __m256 min_x = _mm256_set1_ps(bounds.min.x);
+    __m256 min_y = _mm256_set1_ps(bounds.min.y);
+    __m256 max_x = _mm256_set1_ps(bounds.max.x);
+    __m256 max_y = _mm256_set1_ps(bounds.max.y);
+    __m256 half = _mm256_set1_ps(0.5f);
+
+    // In-lane shuffles leave quads in 0 1 4 5 2 3 6 7 order, this maps a quad to its mask bit
+    static const uint32_t lane_bits[8] = { 0, 1, 4, 5, 2, 3, 6, 7 };
+
+    uint32_t visible_count = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 p0123 = _mm256_loadu_ps(&positions[i].x);
+        __m256 p4567 = _mm256_loadu_ps(&positions[i + 4].x);
+        __m256 s0123 = _mm256_loadu_ps(&sizes[i].x);
+        __m256 s4567 = _mm256_loadu_ps(&sizes[i + 4].x);
+
+        __m256 px = _mm256_shuffle_ps(p0123, p4567, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 py = _mm256_shuffle_ps(p0123, p4567, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 hx = _mm256_mul_ps(_mm256_shuffle_ps(s0123, s4567, _MM_SHUFFLE(2, 0, 2, 0)), half);
+        __m256 hy = _mm256_mul_ps(_mm256_shuffle_ps(s0123, s4567, _MM_SHUFFLE(3, 1, 3, 1)), half);
+
+        __m256 visible = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(_mm256_sub_ps(px, hx), max_x, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_add_ps(px, hx), min_x, _CMP_GE_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(_mm256_sub_ps(py, hy), max_y, _CMP_LE_OQ), _mm256_cmp_ps(_mm256_add_ps(py, hy), min_y, _CMP_GE_OQ)));
+        int mask = _mm256_movemask_ps(visible);
+
+        for (uint32_t quad = 0; quad < 8; quad++)
+        {
+            out_visible[visible_count] = i + quad;
+            visible_count += (mask >> lane_bits[quad]) & 1;
+        }
+    }
+
+    uint32_t tail_count = cull_quads_sse2(positions + i, sizes + i, count - i, bounds, out_visible + visible_count);
+    for (uint32_t t = 0; t < tail_count; t++)
+    {
+        out_visible[visible_count + t] += i;
+    }
+    return visible_count + tail_count;
+}
+
+// SDL has no F16C query, it is CPUID leaf 1 ECX bit 29
+static bool quad_pack_has_f16c(void)
+{
+#if defined(_MSC_VER)
+    int registers[4] = {0};
+    __cpuid(registers, 1);
+    return (registers[2] & (1 << 29)) != 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 29)) != 0;
+#endif
+}
+
+#endif
+
+#if defined(QUAD_PACK_NEON)
+
+static uint16x4_t pack_color_neon(const Vector4f *color)
+{
+    float32x4_t value = vld1q_f32(&color->x);
+    value = vminq_f32(vmaxq_f32(value, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    value = vaddq_f32(vmulq_f32(value, vdupq_n_f32(255.0f)), vdupq_n_f32(0.5f));
+    return vmovn_u32(vcvtq_u32_f32(value));
+}
+
+static void pack_colors_neon(const Vector4f *colors, uint32_t *out_colors, uint32_t count)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        uint8x8_t c01 = vmovn_u16(vcombine_u16(pack_color_neon(&colors[i + 0]), pack_color_neon(&colors[i + 1])));
+        uint8x8_t c23 = vmovn_u16(vcombine_u16(pack_color_neon(&colors[i + 2]), pack_color_neon(&colors[i + 3])));
+        vst1q_u8((uint8_t *)&out_colors[i], vcombine_u8(c01, c23));
+    }
+
+    pack_colors_scalar(colors + i, out_colors + i, count - i);
+}
+
+static void pack_halves_neon(const float *values, uint16_t *out_halves, uint32_t count)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float16x4_t halves = vcvt_f16_f32(vld1q_f32(&values[i]));
+        vst1_u16(&out_halves[i], vreinterpret_u16_f16(halves));
+    }
+
+    pack_halves_scalar(values + i, out_halves + i, count - i);
+}
+
+static uint32_t cull_quads_neon(const Vector2f *positions, const Vector2f *sizes, uint32_t count,
+                                Rect2f bounds, uint32_t *out_visible)
+{
+    float32x4_t min_x = vdupq_n_f32(bounds.min.x);
+    float32x4_t min_y = vdupq_n_f32(bounds.min.y);
+    float32x4_t max_x = vdupq_n_f32(bounds.max.x);
+    float32x4_t max_y = vdupq_n_f32(bounds.max.y);
+
+    uint32_t visible_count = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // vld2 splits interleaved xy pairs into x and y lanes
+        float32x4x2_t p = vld2q_f32(&positions[i].x);
+        float32x4x2_t s = vld2q_f32(&sizes[i].x);
+        float32x4_t hx = vmulq_n_f32(s.val[0], 0.5f);
+        float32x4_t hy = vmulq_n_f32(s.val[1], 0.5f);
+
+        uint32x4_t visible = vandq_u32(
+            vandq_u32(vcleq_f32(vsubq_f32(p.val[0], hx), max_x), vcgeq_f32(vaddq_f32(p.val[0], hx), min_x)),
+            vandq_u32(vcleq_f32(vsubq_f32(p.val[1], hy), max_y), vcgeq_f32(vaddq_f32(p.val[1], hy), min_y)));
+
+        uint32_t lanes[4];
+        vst1q_u32(lanes, visible);
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            out_visible[visible_count] = i + lane;
+            visible_count += lanes[lane] & 1;
+        }
+    }
+
+    uint32_t tail_count = cull_quads_scalar(positions + i, sizes + i, count - i, bounds, out_visible + visible_count);
+    for (uint32_t t = 0; t < tail_count; t++)
+    {
+        out_visible[visible_count + t] += i;
+    }
+    return visible_count + tail_count;
+}
+
+#endif
+
+QuadPackFunctions quad_pack_select(void)
+{
+    QuadPackFunctions functions = { pack_colors_scalar, pack_halves_scalar, cull_quads_scalar, "scalar" };
+
+#if defined(QUAD_PACK_X86)
+    if (SDL_HasAVX2())
+    {
+        // Some CPUs and hypervisors report AVX2 without F16C, halves stay scalar there
+        functions.pack_colors = pack_colors_avx2;
+        functions.cull_quads = cull_quads_avx2;
+        functions.name = "AVX2 without F16C";
+        if (quad_pack_has_f16c())
+        {
+            functions.pack_halves = pack_halves_avx2;
+            functions.name = "AVX2";
+        }
+    }
+    else if (SDL_HasSSE2())
+    {
+        // SSE2 has no half conversion, halves stay scalar
+        functions.pack_colors = pack_colors_sse2;
+        functions.cull_quads = cull_quads_sse2;
+        functions.name = "SSE2";
+    }
+#elif defined(QUAD_PACK_NEON)
+    if (SDL_HasNEON())
+    {
+        functions.pack_colors = pack_colors_neon;
+        functions.pack_halves = pack_halves_neon;
+        functions.cull_quads = cull_quads_neon;
+        functions.name = "NEON";
+    }
+#endif
+
+    return functions;
+}
\ No newline at end of file
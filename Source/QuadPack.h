@@ -0,0 +1,30 @@
+#ifndef _QUAD_PACK_H
+#define _QUAD_PACK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Math.h"
+
+// Bulk converters used to fill batch instance records, every variant gives the same
+// results as pack_color_rgba8 and pack_half, and culling matches quad_is_visible
+typedef void (*PackColorsFunc)(const Vector4f *colors, uint32_t *out_colors, uint32_t count);
+typedef void (*PackHalvesFunc)(const float *values, uint16_t *out_halves, uint32_t count);
+
+// Writes the indices of quads whose AABB overlaps bounds in ascending order, returns how many
+typedef uint32_t (*CullQuadsFunc)(const Vector2f *positions, const Vector2f *sizes, uint32_t count,
+                                  Rect2f bounds, uint32_t *out_visible);
+
+typedef struct QuadPackFunctions
+{
+    PackColorsFunc pack_colors;
+    PackHalvesFunc pack_halves;
+    CullQuadsFunc cull_quads;
+    const char *name;
+} QuadPackFunctions;
+
+bool quad_is_visible(Vector2f position, Vector2f size, Rect2f bounds);
+
+// Picks the widest instruction set the CPU supports (AVX2, SSE2 or NEON, else scalar)
+QuadPackFunctions quad_pack_select(void);
+
+#endif
\ No newline at end of file
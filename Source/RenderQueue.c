@@ -0,0 +1,375 @@
+#include "RenderQueue.h"
+
+#define RENDER_SORT_RADIX_BITS 8
+#define RENDER_SORT_BUCKETS (1 << RENDER_SORT_RADIX_BITS)
+#define RENDER_SORT_PASSES (64 / RENDER_SORT_RADIX_BITS)
+
+bool render_queue_create(RenderQueue *queue, uint32_t initial_capacity)
+{
+    if (!queue)
+    {
+        return false;
+    }
+
+    SDL_memset(queue, 0, sizeof(RenderQueue));
+    queue->command_capacity = initial_capacity > 0 ? initial_capacity : 64;
+
+    // Slot 0 of both tables stays empty so id 0 can mean "none"
+    queue->pipelines = (SDL_GPUGraphicsPipeline **)SDL_calloc(RENDER_QUEUE_MAX_PIPELINES, sizeof(SDL_GPUGraphicsPipeline *));
+    queue->textures = (RenderQueueTexture *)SDL_calloc(RENDER_QUEUE_MAX_TEXTURES, sizeof(RenderQueueTexture));
+    queue->pipeline_count = 1;
+    queue->texture_count = 1;
+
+    queue->commands = (RenderCommand *)SDL_malloc(queue->command_capacity * sizeof(RenderCommand));
+    queue->sort_entries = (RenderSortEntry *)SDL_malloc(queue->command_capacity * sizeof(RenderSortEntry));
+    queue->sort_scratch = (RenderSortEntry *)SDL_malloc(queue->command_capacity * sizeof(RenderSortEntry));
+
+    if (!queue->pipelines || !queue->textures || !queue->commands || !queue->sort_entries || !queue->sort_scratch)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate render queue");
+        render_queue_destroy(queue);
+        return false;
+    }
+
+    return true;
+}
+
+void render_queue_destroy(RenderQueue *queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    if (queue->frames > 0)
+    {
+        SDL_Log("Render queue stats: %.1f commands/frame, %.1f draw calls/frame, %.1f draws saved/frame, %.1f binds/frame",
+                (double)queue->total_stats.commands / queue->frames,
+                (double)queue->total_stats.draw_calls / queue->frames,
+                (double)queue->total_stats.draws_saved / queue->frames,
+                (double)(queue->total_stats.pipeline_binds + queue->total_stats.texture_binds + queue->total_stats.buffer_binds) / queue->frames);
+    }
+
+    SDL_free(queue->pipelines);
+    SDL_free(queue->textures);
+    SDL_free(queue->commands);
+    SDL_free(queue->sort_entries);
+    SDL_free(queue->sort_scratch);
+    SDL_memset(queue, 0, sizeof(RenderQueue));
+}
+
+uint32_t render_queue_register_pipeline(RenderQueue *queue, SDL_GPUGraphicsPipeline *pipeline)
+{
+    if (!queue || !queue->pipelines || !pipeline)
+    {
+        return RENDER_PIPELINE_NONE;
+    }
+
+    for (uint32_t i = 1; i < queue->pipeline_count; i++)
+    {
+        if (queue->pipelines[i] == pipeline)
+        {
+            return i;
+        }
+    }
+
+    if (queue->pipeline_count == RENDER_QUEUE_MAX_PIPELINES)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render queue is out of pipeline ids");
+        return RENDER_PIPELINE_NONE;
+    }
+
+    queue->pipelines[queue->pipeline_count] = pipeline;
+    return queue->pipeline_count++;
+}
+
+uint32_t render_queue_register_texture(RenderQueue *queue, SDL_GPUTexture *texture, SDL_GPUSampler *sampler)
+{
+    if (!queue || !queue->textures || !texture || !sampler)
+    {
+        return RENDER_TEXTURE_NONE;
+    }
+
+    for (uint32_t i = 1; i < queue->texture_count; i++)
+    {
+        if (queue->textures[i].texture == texture && queue->textures[i].sampler == sampler)
+        {
+            return i;
+        }
+    }
+
+    if (queue->texture_count == RENDER_QUEUE_MAX_TEXTURES)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Render queue is out of texture ids");
+        return RENDER_TEXTURE_NONE;
+    }
+
+    queue->textures[queue->texture_count].texture = texture;
+    queue->textures[queue->texture_count].sampler = sampler;
+    return queue->texture_count++;
+}
+
+RenderKey render_key_make(uint32_t layer, uint32_t pipeline, uint32_t texture, uint32_t depth)
+{
+    RenderKey key = 0;
+    key |= (RenderKey)(layer & ((1u << RENDER_KEY_LAYER_BITS) - 1)) << RENDER_KEY_LAYER_SHIFT;
+    key |= (RenderKey)(pipeline & ((1u << RENDER_KEY_PIPELINE_BITS) - 1)) << RENDER_KEY_PIPELINE_SHIFT;
+    key |= (RenderKey)(texture & ((1u << RENDER_KEY_TEXTURE_BITS) - 1)) << RENDER_KEY_TEXTURE_SHIFT;
+    key |= (RenderKey)depth << RENDER_KEY_DEPTH_SHIFT;
+    return key;
+}
+
+uint32_t render_key_depth(float depth)
+{
+    union { float f; uint32_t u; } bits;
+    bits.f = depth;
+
+    // Negative floats flip entirely, positive ones only get the sign bit set
+    return (bits.u & 0x80000000u) ? ~bits.u : (bits.u | 0x80000000u);
+}
+
+void render_queue_reset(RenderQueue *queue)
+{
+    if (!queue)
+    {
+        return;
+    }
+
+    queue->command_count = 0;
+}
+
+static RenderCommand *render_queue_push(RenderQueue *queue)
+{
+    if (queue->command_count == queue->command_capacity)
+    {
+        uint32_t new_capacity = queue->command_capacity * 2;
+        RenderCommand *commands = (RenderCommand *)SDL_realloc(queue->commands, new_capacity * sizeof(RenderCommand));
+        if (!commands)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to grow render queue");
+            return NULL;
+        }
+        queue->commands = commands;
+
+        RenderSortEntry *entries = (RenderSortEntry *)SDL_realloc(queue->sort_entries, new_capacity * sizeof(RenderSortEntry));
+        if (!entries)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to grow render queue");
+            return NULL;
+        }
+        queue->sort_entries = entries;
+
+        RenderSortEntry *scratch = (RenderSortEntry *)SDL_realloc(queue->sort_scratch, new_capacity * sizeof(RenderSortEntry));
+        if (!scratch)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to grow render queue");
+            return NULL;
+        }
+        queue->sort_scratch = scratch;
+        queue->command_capacity = new_capacity;
+    }
+
+    RenderCommand *command = &queue->commands[queue->command_count++];
+    SDL_memset(command, 0, sizeof(RenderCommand));
+    return command;
+}
+
+bool render_queue_submit(RenderQueue *queue, RenderKey key, SDL_GPUBuffer *instance_buffer,
+                         uint32_t vertex_count, uint32_t first_instance, uint32_t instance_count)
+{
+    if (!queue || !queue->commands || !instance_buffer || vertex_count == 0 || instance_count == 0)
+    {
+        return false;
+    }
+
+    RenderCommand *command = render_queue_push(queue);
+    if (!command)
+    {
+        return false;
+    }
+
+    command->key = key;
+    command->instance_buffer = instance_buffer;
+    command->vertex_count = vertex_count;
+    command->first_instance = first_instance;
+    command->instance_count = instance_count;
+    return true;
+}
+
+bool render_queue_submit_indirect(RenderQueue *queue, RenderKey key, SDL_GPUBuffer *instance_buffer,
+                                  SDL_GPUBuffer *indirect_buffer, uint32_t indirect_offset)
+{
+    if (!queue || !queue->commands || !instance_buffer || !indirect_buffer)
+    {
+        return false;
+    }
+
+    RenderCommand *command = render_queue_push(queue);
+    if (!command)
+    {
+        return false;
+    }
+
+    command->key = key;
+    command->instance_buffer = instance_buffer;
+    command->indirect_buffer = indirect_buffer;
+    command->indirect_offset = indirect_offset;
+    return true;
+}
+
+// Stable LSD radix sort, 8 bits per pass. Passes where every key shares the same digit are skipped
+static RenderSortEntry *render_queue_sort(RenderQueue *queue)
+{
+    uint32_t count = queue->command_count;
+    RenderSortEntry *src = queue->sort_entries;
+    RenderSortEntry *dst = queue->sort_scratch;
+
+    uint32_t histograms[RENDER_SORT_PASSES][RENDER_SORT_BUCKETS];
+    SDL_memset(histograms, 0, sizeof(histograms));
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        RenderKey key = queue->commands[i].key;
+        src[i].key = key;
+        src[i].command = i;
+
+        for (uint32_t pass = 0; pass < RENDER_SORT_PASSES; pass++)
+        {
+            histograms[pass][(key >> (pass * RENDER_SORT_RADIX_BITS)) & (RENDER_SORT_BUCKETS - 1)]++;
+        }
+    }
+
+    for (uint32_t pass = 0; pass < RENDER_SORT_PASSES; pass++)
+    {
+        uint32_t *histogram = histograms[pass];
+        uint32_t shift = pass * RENDER_SORT_RADIX_BITS;
+
+        if (histogram[(src[0].key >> shift) & (RENDER_SORT_BUCKETS - 1)] == count)
+        {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < RENDER_SORT_BUCKETS; bucket++)
+        {
+            uint32_t bucket_count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucket_count;
+        }
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            dst[histogram[(src[i].key >> shift) & (RENDER_SORT_BUCKETS - 1)]++] = src[i];
+        }
+
+        RenderSortEntry *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    return src;
+}
+
+void render_queue_execute(RenderQueue *queue, SDL_GPURenderPass *render_pass)
+{
+    if (!queue || !render_pass)
+    {
+        return;
+    }
+
+    SDL_memset(&queue->stats, 0, sizeof(RenderQueueStats));
+    queue->stats.commands = queue->command_count;
+
+    if (queue->command_count > 0)
+    {
+        RenderSortEntry *sorted = render_queue_sort(queue);
+
+        SDL_GPUGraphicsPipeline *bound_pipeline = NULL;
+        uint32_t bound_texture = RENDER_TEXTURE_NONE;
+        SDL_GPUBuffer *bound_buffer = NULL;
+
+        uint32_t i = 0;
+        while (i < queue->command_count)
+        {
+            const RenderCommand *command = &queue->commands[sorted[i].command];
+            uint32_t pipeline_id = (uint32_t)(command->key >> RENDER_KEY_PIPELINE_SHIFT) & (RENDER_QUEUE_MAX_PIPELINES - 1);
+            uint32_t texture_id = (uint32_t)(command->key >> RENDER_KEY_TEXTURE_SHIFT) & (RENDER_QUEUE_MAX_TEXTURES - 1);
+
+            // Merge following commands that continue the same instance run with the same state
+            uint32_t instance_count = command->instance_count;
+            uint32_t next = i + 1;
+            while (!command->indirect_buffer && next < queue->command_count)
+            {
+                const RenderCommand *other = &queue->commands[sorted[next].command];
+                RenderKey state_mask = ~(((RenderKey)1 << RENDER_KEY_TEXTURE_SHIFT) - 1);
+                if ((other->key & state_mask) != (command->key & state_mask) ||
+                    other->indirect_buffer ||
+                    other->instance_buffer != command->instance_buffer ||
+                    other->vertex_count != command->vertex_count ||
+                    other->first_instance != command->first_instance + instance_count)
+                {
+                    break;
+                }
+
+                instance_count += other->instance_count;
+                queue->stats.draws_saved++;
+                next++;
+            }
+
+            SDL_GPUGraphicsPipeline *pipeline = pipeline_id < queue->pipeline_count ? queue->pipelines[pipeline_id] : NULL;
+            if (!pipeline)
+            {
+                i = next;
+                continue;
+            }
+
+            if (pipeline != bound_pipeline)
+            {
+                SDL_BindGPUGraphicsPipeline(render_pass, pipeline);
+                bound_pipeline = pipeline;
+                queue->stats.pipeline_binds++;
+            }
+
+            if (texture_id != RENDER_TEXTURE_NONE && texture_id != bound_texture && texture_id < queue->texture_count)
+            {
+                SDL_GPUTextureSamplerBinding texture_binding = {0};
+                texture_binding.texture = queue->textures[texture_id].texture;
+                texture_binding.sampler = queue->textures[texture_id].sampler;
+                SDL_BindGPUFragmentSamplers(render_pass, 0, &texture_binding, 1);
+                bound_texture = texture_id;
+                queue->stats.texture_binds++;
+            }
+
+            if (command->instance_buffer != bound_buffer)
+            {
+                SDL_GPUBufferBinding instance_binding = {0};
+                instance_binding.buffer = command->instance_buffer;
+                instance_binding.offset = 0;
+                SDL_BindGPUVertexBuffers(render_pass, 0, &instance_binding, 1);
+                bound_buffer = command->instance_buffer;
+                queue->stats.buffer_binds++;
+            }
+
+            // Indirect counts come from the GPU, so those draws are never merged
+            if (command->indirect_buffer)
+            {
+                SDL_DrawGPUPrimitivesIndirect(render_pass, command->indirect_buffer, command->indirect_offset, 1);
+            }
+            else
+            {
+                SDL_DrawGPUPrimitives(render_pass, command->vertex_count, instance_count, 0, command->first_instance);
+            }
+            queue->stats.draw_calls++;
+
+            i = next;
+        }
+    }
+
+    queue->total_stats.commands += queue->stats.commands;
+    queue->total_stats.draw_calls += queue->stats.draw_calls;
+    queue->total_stats.pipeline_binds += queue->stats.pipeline_binds;
+    queue->total_stats.texture_binds += queue->stats.texture_binds;
+    queue->total_stats.buffer_binds += queue->stats.buffer_binds;
+    queue->total_stats.draws_saved += queue->stats.draws_saved;
+    queue->frames++;
+}
\ No newline at end of file
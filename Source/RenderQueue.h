@@ -0,0 +1,103 @@
+#ifndef _RENDER_QUEUE_H
+#define _RENDER_QUEUE_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Sort key layout, most significant first: layer | pipeline | texture | depth
+#define RENDER_KEY_LAYER_BITS 8
+#define RENDER_KEY_PIPELINE_BITS 10
+#define RENDER_KEY_TEXTURE_BITS 14
+#define RENDER_KEY_DEPTH_BITS 32
+
+#define RENDER_KEY_DEPTH_SHIFT 0
+#define RENDER_KEY_TEXTURE_SHIFT (RENDER_KEY_DEPTH_SHIFT + RENDER_KEY_DEPTH_BITS)
+#define RENDER_KEY_PIPELINE_SHIFT (RENDER_KEY_TEXTURE_SHIFT + RENDER_KEY_TEXTURE_BITS)
+#define RENDER_KEY_LAYER_SHIFT (RENDER_KEY_PIPELINE_SHIFT + RENDER_KEY_PIPELINE_BITS)
+
+#define RENDER_QUEUE_MAX_PIPELINES (1 << RENDER_KEY_PIPELINE_BITS)
+#define RENDER_QUEUE_MAX_TEXTURES (1 << RENDER_KEY_TEXTURE_BITS)
+
+// Id 0 is never handed out: pipeline 0 marks a failed registration, texture 0 samples nothing
+#define RENDER_PIPELINE_NONE 0
+#define RENDER_TEXTURE_NONE 0
+
+typedef uint64_t RenderKey;
+
+typedef struct RenderCommand
+{
+    RenderKey key;
+    SDL_GPUBuffer *instance_buffer;
+    uint32_t vertex_count;
+    uint32_t first_instance;
+    uint32_t instance_count;
+    SDL_GPUBuffer *indirect_buffer; // when set, the draw arguments are read from here
+    uint32_t indirect_offset;
+} RenderCommand;
+
+typedef struct RenderSortEntry
+{
+    RenderKey key;
+    uint32_t command;
+} RenderSortEntry;
+
+typedef struct RenderQueueTexture
+{
+    SDL_GPUTexture *texture;
+    SDL_GPUSampler *sampler;
+} RenderQueueTexture;
+
+typedef struct RenderQueueStats
+{
+    uint32_t commands;
+    uint32_t draw_calls;
+    uint32_t pipeline_binds;
+    uint32_t texture_binds;
+    uint32_t buffer_binds;
+    uint32_t draws_saved; // commands merged into a previous draw
+} RenderQueueStats;
+
+// Collects a frame's draws, sorts them by key and emits them with redundant binds removed
+typedef struct RenderQueue
+{
+    SDL_GPUGraphicsPipeline **pipelines;
+    uint32_t pipeline_count;
+    RenderQueueTexture *textures;
+    uint32_t texture_count;
+
+    RenderCommand *commands;
+    RenderSortEntry *sort_entries;
+    RenderSortEntry *sort_scratch;
+    uint32_t command_count;
+    uint32_t command_capacity;
+
+    RenderQueueStats stats;       // last executed frame
+    RenderQueueStats total_stats; // every frame since creation
+    uint32_t frames;
+} RenderQueue;
+
+bool render_queue_create(RenderQueue *queue, uint32_t initial_capacity);
+void render_queue_destroy(RenderQueue *queue);
+
+// Registered objects are referenced from keys by id, they must outlive the queue's use of them
+uint32_t render_queue_register_pipeline(RenderQueue *queue, SDL_GPUGraphicsPipeline *pipeline);
+uint32_t render_queue_register_texture(RenderQueue *queue, SDL_GPUTexture *texture, SDL_GPUSampler *sampler);
+
+RenderKey render_key_make(uint32_t layer, uint32_t pipeline, uint32_t texture, uint32_t depth);
+
+// Maps a float onto uint32 so larger values sort later
+uint32_t render_key_depth(float depth);
+
+void render_queue_reset(RenderQueue *queue);
+bool render_queue_submit(RenderQueue *queue, RenderKey key, SDL_GPUBuffer *instance_buffer,
+                         uint32_t vertex_count, uint32_t first_instance, uint32_t instance_count);
+
+// The indirect buffer holds one SDL_GPUIndirectDrawCommand at indirect_offset
+bool render_queue_submit_indirect(RenderQueue *queue, RenderKey key, SDL_GPUBuffer *instance_buffer,
+                                  SDL_GPUBuffer *indirect_buffer, uint32_t indirect_offset);
+
+// Sorts and records every submitted draw into the pass, the caller binds pass-wide resources
+void render_queue_execute(RenderQueue *queue, SDL_GPURenderPass *render_pass);
+
+#endif
\ No newline at end of file
@@ -1,97 +1,360 @@
 #include "Renderer.h"
 #include "Buffers.h"
+#include "QuadPack.h"
 #include <stdlib.h>
 #include <string.h>
 
-bool batch_renderer_2d_init(BatchRenderer2D *renderer, SDL_GPUDevice *device)
+uint32_t pack_color_rgba8(Vector4f color)
 {
-    if (!renderer || !device)
+    float channels[4] = { color.x, color.y, color.z, color.w };
+    uint32_t packed = 0;
+    
+    for (int i = 0; i < 4; i++)
     {
-        return false;
+        float c = channels[i] < 0.0f ? 0.0f : (channels[i] > 1.0f ? 1.0f : channels[i]);
+        packed |= (uint32_t)(c * 255.0f + 0.5f) << (i * 8);
     }
     
-    memset(renderer, 0, sizeof(BatchRenderer2D));
-    renderer->device = device;
+    return packed;
+}
+
+static void batch_chunk_release(SDL_GPUDevice *device, BatchChunk *chunk)
+{
+    if (chunk->instances)
+    {
+        SDL_UnmapGPUTransferBuffer(device, chunk->staging_buffer);
+        chunk->instances = NULL;
+    }
     
-    // Create vertex buffer (large enough for 1 million quads = 4 million vertices)
-    SDL_GPUBufferCreateInfo vertex_buffer_info = {0};
-    vertex_buffer_info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
-    vertex_buffer_info.size = MAX_VERTICES * sizeof(Vertex2D);
+    if (chunk->staging_buffer)
+    {
+        SDL_ReleaseGPUTransferBuffer(device, chunk->staging_buffer);
+        chunk->staging_buffer = NULL;
+    }
     
-    renderer->vertex_buffer = SDL_CreateGPUBuffer(device, &vertex_buffer_info);
-    if (!renderer->vertex_buffer)
+    if (chunk->instance_buffer)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create vertex buffer for batch renderer: %s", SDL_GetError());
-        return false;
+        SDL_ReleaseGPUBuffer(device, chunk->instance_buffer);
+        chunk->instance_buffer = NULL;
+    }
+}
+
+static BatchChunk *batch_renderer_2d_add_chunk(BatchRenderer2D *renderer)
+{
+    uint32_t capacity = BATCH_INITIAL_CHUNK_QUADS;
+    if (renderer->chunk_count > 0)
+    {
+        capacity = renderer->chunks[renderer->chunk_count - 1].capacity * 2;
+        if (capacity > BATCH_MAX_CHUNK_QUADS)
+        {
+            capacity = BATCH_MAX_CHUNK_QUADS;
+        }
     }
     
-    // Create index buffer (1 million quads = 6 million indices)
-    SDL_GPUBufferCreateInfo index_buffer_info = {0};
-    index_buffer_info.usage = SDL_GPU_BUFFERUSAGE_INDEX;
-    index_buffer_info.size = MAX_INDICES * sizeof(uint32_t);
+    // Instance buffer + staging buffer
+    uint64_t chunk_memory = (uint64_t)capacity * renderer->instance_size * 2;
+    if (renderer->memory_used + chunk_memory > renderer->memory_cap)
+    {
+        renderer->memory_cap_hit = true;
+        return NULL;
+    }
     
-    renderer->index_buffer = SDL_CreateGPUBuffer(device, &index_buffer_info);
-    if (!renderer->index_buffer)
+    if (renderer->chunk_count == renderer->chunk_capacity)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create index buffer for batch renderer: %s", SDL_GetError());
-        SDL_ReleaseGPUBuffer(device, renderer->vertex_buffer);
-        return false;
+        uint32_t new_capacity = renderer->chunk_capacity ? renderer->chunk_capacity * 2 : 8;
+        BatchChunk *chunks = (BatchChunk *)realloc(renderer->chunks, new_capacity * sizeof(BatchChunk));
+        if (!chunks)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to grow batch chunk list");
+            return NULL;
+        }
+        renderer->chunks = chunks;
+        renderer->chunk_capacity = new_capacity;
     }
     
-    // Pre-generate indices (this pattern repeats for all quads)
-    uint32_t *indices = (uint32_t *)malloc(MAX_INDICES * sizeof(uint32_t));
-    if (!indices)
+    BatchChunk *chunk = &renderer->chunks[renderer->chunk_count];
+    memset(chunk, 0, sizeof(BatchChunk));
+    chunk->capacity = capacity;
+    
+    // One record per quad, no index buffer needed
+    SDL_GPUBufferCreateInfo instance_buffer_info = {0};
+    instance_buffer_info.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
+    instance_buffer_info.size = capacity * renderer->instance_size;
+    
+    chunk->instance_buffer = SDL_CreateGPUBuffer(renderer->device, &instance_buffer_info);
+    if (!chunk->instance_buffer)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate memory for indices");
-        SDL_ReleaseGPUBuffer(device, renderer->vertex_buffer);
-        SDL_ReleaseGPUBuffer(device, renderer->index_buffer);
-        return false;
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create instance buffer for batch chunk: %s", SDL_GetError());
+        return NULL;
     }
     
-    for (uint32_t i = 0; i < MAX_QUADS; i++)
+    SDL_GPUTransferBufferCreateInfo staging_buffer_info = {0};
+    staging_buffer_info.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    staging_buffer_info.size = capacity * renderer->instance_size;
+    
+    chunk->staging_buffer = SDL_CreateGPUTransferBuffer(renderer->device, &staging_buffer_info);
+    if (!chunk->staging_buffer)
     {
-        uint32_t vertex_offset = i * 4;
-        uint32_t index_offset = i * 6;
-        
-        // First triangle (0, 1, 2)
-        indices[index_offset + 0] = vertex_offset + 0;
-        indices[index_offset + 1] = vertex_offset + 1;
-        indices[index_offset + 2] = vertex_offset + 2;
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create staging buffer for batch chunk: %s", SDL_GetError());
+        batch_chunk_release(renderer->device, chunk);
+        return NULL;
+    }
+    
+    renderer->chunk_count++;
+    renderer->memory_used += chunk_memory;
+    return chunk;
+}
+
+// Makes the next chunk current for this batch, creating it if needed
+static BatchChunk *batch_renderer_2d_next_chunk(BatchRenderer2D *renderer)
+{
+    BatchChunk *chunk = NULL;
+    if (renderer->active_chunk_count < renderer->chunk_count)
+    {
+        chunk = &renderer->chunks[renderer->active_chunk_count];
+    }
+    else
+    {
+        chunk = batch_renderer_2d_add_chunk(renderer);
+        if (!chunk)
+        {
+            return NULL;
+        }
+    }
+    
+    // Cycle so last frame's copy out of this buffer can still be in flight
+    chunk->instances = (uint8_t *)SDL_MapGPUTransferBuffer(renderer->device, chunk->staging_buffer, true);
+    if (!chunk->instances)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to map batch staging buffer: %s", SDL_GetError());
+        return NULL;
+    }
+    
+    chunk->quad_count = 0;
+    renderer->active_chunk_count++;
+    return chunk;
+}
+
+uint16_t pack_half(float value)
+{
+    union { float f; uint32_t u; } bits;
+    bits.f = value;
+    
+    uint32_t sign = (bits.u >> 16) & 0x8000;
+    int32_t exponent = (int32_t)((bits.u >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits.u & 0x7fffff;
+    
+    // Overflow, infinity and NaN
+    if (exponent >= 31)
+    {
+        bool is_nan = ((bits.u >> 23) & 0xff) == 0xff && mantissa != 0;
+        return (uint16_t)(sign | (is_nan ? 0x7e00 : 0x7c00));
+    }
+    
+    // Denormals, or zero when too small
+    if (exponent <= 0)
+    {
+        if (exponent < -10)
+        {
+            return (uint16_t)sign;
+        }
         
-        // Second triangle (2, 3, 0)
-        indices[index_offset + 3] = vertex_offset + 2;
-        indices[index_offset + 4] = vertex_offset + 3;
-        indices[index_offset + 5] = vertex_offset + 0;
+        mantissa |= 0x800000;
+        uint32_t shift = (uint32_t)(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+        {
+            half += 1;
+        }
+        return (uint16_t)(sign | half);
     }
     
-    // Upload indices to GPU (one-time upload since indices never change)
-    if (!upload_to_gpu_buffer(device, renderer->index_buffer, indices, MAX_INDICES * sizeof(uint32_t), 0))
+    // Round to nearest even (same as F16C and NEON), a carry out of the mantissa bumps the exponent
+    uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    {
+        half += 1;
+    }
+    return (uint16_t)half;
+}
+
+uint32_t batch_vertex_format_size(BatchVertexFormat format)
+{
+    switch (format)
+    {
+        case BATCH_VERTEX_FORMAT_COMPACT:
+            return sizeof(CompactQuadInstance);
+        case BATCH_VERTEX_FORMAT_SHAPE:
+            return sizeof(ShapeInstance);
+        case BATCH_VERTEX_FORMAT_FULL:
+        default:
+            return sizeof(QuadInstance);
+    }
+}
+
+void batch_vertex_format_write(BatchVertexFormat format, void *record, Vector2f position, Vector2f size, Vector4f color)
+{
+    if (format == BATCH_VERTEX_FORMAT_COMPACT)
+    {
+        CompactQuadInstance *instance = (CompactQuadInstance *)record;
+        instance->position[0] = pack_half(position.x);
+        instance->position[1] = pack_half(position.y);
+        instance->size[0] = pack_half(size.x);
+        instance->size[1] = pack_half(size.y);
+        instance->color = pack_color_rgba8(color);
+    }
+    else if (format == BATCH_VERTEX_FORMAT_SHAPE)
+    {
+        ShapeInstance *instance = (ShapeInstance *)record;
+        instance->position = position;
+        instance->size = size;
+        instance->color = pack_color_rgba8(color);
+        instance->shape = SHAPE_TYPE_QUAD;
+        instance->params = (Vector4f){0.0f, 0.0f, 0.0f, 0.0f};
+    }
+    else
+    {
+        QuadInstance *instance = (QuadInstance *)record;
+        instance->position = position;
+        instance->size = size;
+        instance->color = pack_color_rgba8(color);
+    }
+}
+
+const char *batch_vertex_format_shader(BatchVertexFormat format)
+{
+    switch (format)
+    {
+        case BATCH_VERTEX_FORMAT_COMPACT:
+            return "Resources/Shaders/2d_compact.vert.spv";
+        case BATCH_VERTEX_FORMAT_SHAPE:
+            return "Resources/Shaders/2d_shape.vert.spv";
+        case BATCH_VERTEX_FORMAT_FULL:
+        default:
+            return "Resources/Shaders/2d.vert.spv";
+    }
+}
+
+const char *batch_vertex_format_fragment_shader(BatchVertexFormat format)
+{
+    if (format == BATCH_VERTEX_FORMAT_SHAPE)
+    {
+        return "Resources/Shaders/2d_shape.frag.spv";
+    }
+    return "Resources/Shaders/2d.frag.spv";
+}
+
+// Current chunk, or the next one when it is full. NULL once the memory cap is hit or a chunk
+// could not be allocated or mapped
+static BatchChunk *batch_renderer_2d_chunk_with_space(BatchRenderer2D *renderer)
+{
+    BatchChunk *chunk = &renderer->chunks[renderer->active_chunk_count - 1];
+    if (chunk->quad_count < chunk->capacity)
+    {
+        return chunk;
+    }
+    
+    if (renderer->dropped_quads > 0)
+    {
+        return NULL;
+    }
+    
+    return batch_renderer_2d_next_chunk(renderer);
+}
+
+// Writes count records in blocks, colors and halves are converted with the selected SIMD path
+static void write_quad_records(uint8_t *records, BatchVertexFormat format, const QuadPackFunctions *pack,
+                               const Vector2f *positions, const Vector2f *sizes, const Vector4f *colors,
+                               uint32_t count)
+{
+    uint32_t packed_colors[BATCH_PACK_BLOCK_QUADS];
+    uint16_t packed_positions[BATCH_PACK_BLOCK_QUADS * 2];
+    uint16_t packed_sizes[BATCH_PACK_BLOCK_QUADS * 2];
+    
+    for (uint32_t first = 0; first < count; first += BATCH_PACK_BLOCK_QUADS)
+    {
+        uint32_t block = count - first < BATCH_PACK_BLOCK_QUADS ? count - first : BATCH_PACK_BLOCK_QUADS;
+        pack->pack_colors(colors + first, packed_colors, block);
+        
+        if (format == BATCH_VERTEX_FORMAT_COMPACT)
+        {
+            pack->pack_halves(&positions[first].x, packed_positions, block * 2);
+            pack->pack_halves(&sizes[first].x, packed_sizes, block * 2);
+            
+            CompactQuadInstance *instances = (CompactQuadInstance *)records + first;
+            for (uint32_t i = 0; i < block; i++)
+            {
+                instances[i].position[0] = packed_positions[i * 2 + 0];
+                instances[i].position[1] = packed_positions[i * 2 + 1];
+                instances[i].size[0] = packed_sizes[i * 2 + 0];
+                instances[i].size[1] = packed_sizes[i * 2 + 1];
+                instances[i].color = packed_colors[i];
+            }
+        }
+        else if (format == BATCH_VERTEX_FORMAT_SHAPE)
+        {
+            ShapeInstance *instances = (ShapeInstance *)records + first;
+            for (uint32_t i = 0; i < block; i++)
+            {
+                instances[i].position = positions[first + i];
+                instances[i].size = sizes[first + i];
+                instances[i].color = packed_colors[i];
+                instances[i].shape = SHAPE_TYPE_QUAD;
+                instances[i].params = (Vector4f){0.0f, 0.0f, 0.0f, 0.0f};
+            }
+        }
+        else
+        {
+            QuadInstance *instances = (QuadInstance *)records + first;
+            for (uint32_t i = 0; i < block; i++)
+            {
+                instances[i].position = positions[first + i];
+                instances[i].size = sizes[first + i];
+                instances[i].color = packed_colors[i];
+            }
+        }
+    }
+}
+
+bool batch_renderer_2d_init(BatchRenderer2D *renderer, SDL_GPUDevice *device, UploadQueue *upload_queue, BatchVertexFormat format)
+{
+    if (!renderer || !device)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload index buffer for batch renderer");
-        free(indices);
-        SDL_ReleaseGPUBuffer(device, renderer->vertex_buffer);
-        SDL_ReleaseGPUBuffer(device, renderer->index_buffer);
         return false;
     }
     
-    free(indices);
+    memset(renderer, 0, sizeof(BatchRenderer2D));
+    renderer->device = device;
+    renderer->upload_queue = upload_queue;
+    renderer->format = format;
+    renderer->instance_size = batch_vertex_format_size(format);
+    renderer->pack = quad_pack_select();
     
-    // Allocate CPU-side vertex array
-    renderer->vertices = (Vertex2D *)malloc(MAX_VERTICES * sizeof(Vertex2D));
-    if (!renderer->vertices)
+    renderer->reserve_mutex = SDL_CreateMutex();
+    if (!renderer->reserve_mutex)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to allocate memory for vertices");
-        SDL_ReleaseGPUBuffer(device, renderer->vertex_buffer);
-        SDL_ReleaseGPUBuffer(device, renderer->index_buffer);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create batch reserve mutex: %s", SDL_GetError());
         return false;
     }
+    renderer->memory_cap = BATCH_DEFAULT_MEMORY_CAP;
     
-    renderer->vertex_count = 0;
-    renderer->quad_count = 0;
-    renderer->in_batch = false;
+    // Start with one small chunk, more are added as batches grow
+    if (!batch_renderer_2d_add_chunk(renderer))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create initial batch chunk");
+        free(renderer->chunks);
+        renderer->chunks = NULL;
+        SDL_DestroyMutex(renderer->reserve_mutex);
+        renderer->reserve_mutex = NULL;
+        return false;
+    }
     
-    SDL_Log("Batch renderer initialized: %u max quads (%u vertices, %u indices)", 
-            MAX_QUADS, MAX_VERTICES, MAX_INDICES);
+    SDL_Log("Batch renderer initialized: %u quads per chunk up to %u, %llu byte memory cap (%u bytes per quad, %s packing)", 
+            BATCH_INITIAL_CHUNK_QUADS, BATCH_MAX_CHUNK_QUADS,
+            (unsigned long long)renderer->memory_cap, renderer->instance_size, renderer->pack.name);
     
     return true;
 }
@@ -103,39 +366,83 @@ void batch_renderer_2d_destroy(BatchRenderer2D *renderer)
         return;
     }
     
-    if (renderer->vertices)
+    if (renderer->total_submitted_quads + renderer->total_culled_quads > 0)
     {
-        free(renderer->vertices);
-        renderer->vertices = NULL;
+        SDL_Log("Batch renderer stats: %llu quads submitted, %llu culled",
+                (unsigned long long)renderer->total_submitted_quads, (unsigned long long)renderer->total_culled_quads);
     }
     
-    if (renderer->index_buffer)
+    for (uint32_t i = 0; i < renderer->chunk_count; i++)
     {
-        SDL_ReleaseGPUBuffer(renderer->device, renderer->index_buffer);
-        renderer->index_buffer = NULL;
+        batch_chunk_release(renderer->device, &renderer->chunks[i]);
     }
     
-    if (renderer->vertex_buffer)
+    free(renderer->chunks);
+    renderer->chunks = NULL;
+    renderer->chunk_count = 0;
+    renderer->chunk_capacity = 0;
+    renderer->active_chunk_count = 0;
+    renderer->memory_used = 0;
+    
+    if (renderer->reserve_mutex)
     {
-        SDL_ReleaseGPUBuffer(renderer->device, renderer->vertex_buffer);
-        renderer->vertex_buffer = NULL;
+        SDL_DestroyMutex(renderer->reserve_mutex);
+        renderer->reserve_mutex = NULL;
     }
     
     renderer->device = NULL;
-    renderer->vertex_count = 0;
+    renderer->upload_queue = NULL;
     renderer->quad_count = 0;
     renderer->in_batch = false;
 }
 
-void batch_renderer_2d_begin(BatchRenderer2D *renderer)
+void batch_renderer_2d_set_memory_cap(BatchRenderer2D *renderer, uint64_t memory_cap)
+{
+    if (!renderer)
+    {
+        return;
+    }
+    
+    renderer->memory_cap = memory_cap;
+}
+
+void batch_renderer_2d_set_cull_rect(BatchRenderer2D *renderer, Rect2f cull_rect)
 {
     if (!renderer)
     {
         return;
     }
     
-    renderer->vertex_count = 0;
+    renderer->cull_rect = cull_rect;
+    renderer->cull_enabled = true;
+}
+
+void batch_renderer_2d_disable_culling(BatchRenderer2D *renderer)
+{
+    if (renderer)
+    {
+        renderer->cull_enabled = false;
+    }
+}
+
+void batch_renderer_2d_begin(BatchRenderer2D *renderer)
+{
+    if (!renderer || !renderer->device)
+    {
+        return;
+    }
+    
+    renderer->active_chunk_count = 0;
     renderer->quad_count = 0;
+    renderer->culled_quads = 0;
+    renderer->dropped_quads = 0;
+    renderer->memory_cap_hit = false;
+    
+    if (!batch_renderer_2d_next_chunk(renderer))
+    {
+        return;
+    }
+    
     renderer->in_batch = true;
 }
 
@@ -148,88 +455,320 @@ void batch_renderer_2d_add_quad(BatchRenderer2D *renderer,
         return;
     }
     
-    // Check if we have space for another quad
-    if (renderer->quad_count >= MAX_QUADS)
+    if (renderer->cull_enabled && !quad_is_visible(position, size, renderer->cull_rect))
     {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Batch renderer is full, cannot add more quads");
+        renderer->culled_quads++;
         return;
     }
     
-    // Calculate quad corners
-    float x0 = position.x - size.x * 0.5f;
-    float y0 = position.y - size.y * 0.5f;
-    float x1 = position.x + size.x * 0.5f;
-    float y1 = position.y + size.y * 0.5f;
+    BatchChunk *chunk = batch_renderer_2d_chunk_with_space(renderer);
+    if (!chunk)
+    {
+        renderer->dropped_quads++;
+        return;
+    }
     
-    // Add 4 vertices for the quad
-    uint32_t base_index = renderer->vertex_count;
+    // Corners are expanded on the GPU, only the quad itself is stored
+    uint8_t *record = chunk->instances + (size_t)chunk->quad_count * renderer->instance_size;
+    batch_vertex_format_write(renderer->format, record, position, size, color);
     
-    // Bottom-left
-    renderer->vertices[base_index + 0].position.x = x0;
-    renderer->vertices[base_index + 0].position.y = y0;
-    renderer->vertices[base_index + 0].color = color;
+    chunk->quad_count += 1;
+    renderer->quad_count += 1;
+}
+
+static void batch_renderer_2d_add_shape(BatchRenderer2D *renderer, Vector2f position, Vector2f size,
+                                        ShapeType shape, Vector4f params, Vector4f color)
+{
+    if (!renderer || !renderer->in_batch || renderer->format != BATCH_VERTEX_FORMAT_SHAPE)
+    {
+        return;
+    }
     
-    // Bottom-right
-    renderer->vertices[base_index + 1].position.x = x1;
-    renderer->vertices[base_index + 1].position.y = y0;
-    renderer->vertices[base_index + 1].color = color;
+    if (renderer->cull_enabled && !quad_is_visible(position, size, renderer->cull_rect))
+    {
+        renderer->culled_quads++;
+        return;
+    }
     
-    // Top-right
-    renderer->vertices[base_index + 2].position.x = x1;
-    renderer->vertices[base_index + 2].position.y = y1;
-    renderer->vertices[base_index + 2].color = color;
+    BatchChunk *chunk = batch_renderer_2d_chunk_with_space(renderer);
+    if (!chunk)
+    {
+        renderer->dropped_quads++;
+        return;
+    }
     
-    // Top-left
-    renderer->vertices[base_index + 3].position.x = x0;
-    renderer->vertices[base_index + 3].position.y = y1;
-    renderer->vertices[base_index + 3].color = color;
+    ShapeInstance *instance = (ShapeInstance *)chunk->instances + chunk->quad_count;
+    instance->position = position;
+    instance->size = size;
+    instance->color = pack_color_rgba8(color);
+    instance->shape = shape;
+    instance->params = params;
     
-    renderer->vertex_count += 4;
+    chunk->quad_count += 1;
     renderer->quad_count += 1;
 }
 
-void batch_renderer_2d_end(BatchRenderer2D *renderer)
+void batch_renderer_2d_add_circle(BatchRenderer2D *renderer, Vector2f center, float radius, float outline, Vector4f color)
 {
-    if (!renderer || !renderer->in_batch)
+    Vector2f size = {radius * 2.0f, radius * 2.0f};
+    batch_renderer_2d_add_shape(renderer, center, size, SHAPE_TYPE_CIRCLE, (Vector4f){outline, 0.0f, 0.0f, 0.0f}, color);
+}
+
+void batch_renderer_2d_add_rounded_rect(BatchRenderer2D *renderer, Vector2f position, Vector2f size, float corner_radius, float outline, Vector4f color)
+{
+    batch_renderer_2d_add_shape(renderer, position, size, SHAPE_TYPE_ROUNDED_RECT, (Vector4f){outline, corner_radius, 0.0f, 0.0f}, color);
+}
+
+void batch_renderer_2d_add_line(BatchRenderer2D *renderer, Vector2f start, Vector2f end, float thickness, Vector4f color)
+{
+    // The quad is the segment's bounding box grown by the thickness, the shader measures
+    // the distance to the segment itself
+    Vector2f center = {(start.x + end.x) * 0.5f, (start.y + end.y) * 0.5f};
+    Vector2f half_segment = {(end.x - start.x) * 0.5f, (end.y - start.y) * 0.5f};
+    Vector2f size = {SDL_fabsf(end.x - start.x) + thickness, SDL_fabsf(end.y - start.y) + thickness};
+    
+    batch_renderer_2d_add_shape(renderer, center, size, SHAPE_TYPE_LINE,
+                                (Vector4f){thickness, 0.0f, half_segment.x, half_segment.y}, color);
+}
+
+static void batch_renderer_2d_append_quads(BatchRenderer2D *renderer, 
+                                           const Vector2f *positions, const Vector2f *sizes, 
+                                           const Vector4f *colors, uint32_t count)
+{
+    // Fill chunks a run at a time, spilling into new chunks as they fill up
+    uint32_t submitted = 0;
+    while (submitted < count)
+    {
+        BatchChunk *chunk = batch_renderer_2d_chunk_with_space(renderer);
+        if (!chunk)
+        {
+            renderer->dropped_quads += count - submitted;
+            return;
+        }
+        
+        uint32_t run = chunk->capacity - chunk->quad_count;
+        if (run > count - submitted)
+        {
+            run = count - submitted;
+        }
+        
+        uint8_t *records = chunk->instances + (size_t)chunk->quad_count * renderer->instance_size;
+        write_quad_records(records, renderer->format, &renderer->pack,
+                           positions + submitted, sizes + submitted, colors + submitted, run);
+        
+        chunk->quad_count += run;
+        renderer->quad_count += run;
+        submitted += run;
+    }
+}
+
+void batch_renderer_2d_add_quads(BatchRenderer2D *renderer, 
+                                  const Vector2f *positions, const Vector2f *sizes, 
+                                  const Vector4f *colors, uint32_t count)
+{
+    if (!renderer || !renderer->in_batch || !positions || !sizes || !colors)
     {
         return;
     }
     
-    if (renderer->vertex_count == 0)
+    if (!renderer->cull_enabled)
     {
-        renderer->in_batch = false;
+        batch_renderer_2d_append_quads(renderer, positions, sizes, colors, count);
         return;
     }
     
-    // Upload vertex data to GPU using helper function
-    size_t upload_size = renderer->vertex_count * sizeof(Vertex2D);
-    if (!upload_to_gpu_buffer(renderer->device, renderer->vertex_buffer, renderer->vertices, upload_size, 0))
+    // Cull a block at a time and compact the survivors before packing
+    uint32_t visible[BATCH_PACK_BLOCK_QUADS];
+    Vector2f visible_positions[BATCH_PACK_BLOCK_QUADS];
+    Vector2f visible_sizes[BATCH_PACK_BLOCK_QUADS];
+    Vector4f visible_colors[BATCH_PACK_BLOCK_QUADS];
+    
+    for (uint32_t first = 0; first < count; first += BATCH_PACK_BLOCK_QUADS)
+    {
+        uint32_t block = count - first < BATCH_PACK_BLOCK_QUADS ? count - first : BATCH_PACK_BLOCK_QUADS;
+        uint32_t visible_count = renderer->pack.cull_quads(positions + first, sizes + first, block,
+                                                           renderer->cull_rect, visible);
+        renderer->culled_quads += block - visible_count;
+        
+        if (visible_count == block)
+        {
+            batch_renderer_2d_append_quads(renderer, positions + first, sizes + first, colors + first, block);
+            continue;
+        }
+        
+        for (uint32_t i = 0; i < visible_count; i++)
+        {
+            uint32_t index = first + visible[i];
+            visible_positions[i] = positions[index];
+            visible_sizes[i] = sizes[index];
+            visible_colors[i] = colors[index];
+        }
+        batch_renderer_2d_append_quads(renderer, visible_positions, visible_sizes, visible_colors, visible_count);
+    }
+}
+
+BatchRange batch_renderer_2d_reserve(BatchRenderer2D *renderer, uint32_t count)
+{
+    BatchRange range = {0};
+    if (!renderer || !renderer->in_batch || count == 0)
     {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload batch vertex data");
+        return range;
     }
     
-    renderer->in_batch = false;
+    range.format = renderer->format;
+    range.instance_size = renderer->instance_size;
+    range.pack = renderer->pack;
+    
+    SDL_LockMutex(renderer->reserve_mutex);
+    
+    // Claim space chunk by chunk, the range records where each piece landed
+    while (range.count < count && range.segment_count < BATCH_RANGE_MAX_SEGMENTS)
+    {
+        BatchChunk *chunk = batch_renderer_2d_chunk_with_space(renderer);
+        if (!chunk)
+        {
+            renderer->dropped_quads += count - range.count;
+            break;
+        }
+        
+        uint32_t run = chunk->capacity - chunk->quad_count;
+        if (run > count - range.count)
+        {
+            run = count - range.count;
+        }
+        
+        BatchRangeSegment *segment = &range.segments[range.segment_count++];
+        segment->instances = chunk->instances + (size_t)chunk->quad_count * renderer->instance_size;
+        segment->first = range.count;
+        segment->count = run;
+        
+        chunk->quad_count += run;
+        renderer->quad_count += run;
+        range.count += run;
+    }
+    
+    SDL_UnlockMutex(renderer->reserve_mutex);
+    
+    return range;
 }
 
-void batch_renderer_2d_draw(BatchRenderer2D *renderer, SDL_GPURenderPass *render_pass)
+void batch_range_write_quads(const BatchRange *range, uint32_t first, 
+                             const Vector2f *positions, const Vector2f *sizes, 
+                             const Vector4f *colors, uint32_t count)
 {
-    if (!renderer || !render_pass || renderer->quad_count == 0)
+    if (!range || !positions || !sizes || !colors || first >= range->count)
     {
         return;
     }
     
-    SDL_GPUBufferBinding vertex_binding = {0};
-    vertex_binding.buffer = renderer->vertex_buffer;
-    vertex_binding.offset = 0;
+    if (count > range->count - first)
+    {
+        count = range->count - first;
+    }
     
-    SDL_BindGPUVertexBuffers(render_pass, 0, &vertex_binding, 1);
+    uint32_t end = first + count;
+    for (uint32_t i = 0; i < range->segment_count; i++)
+    {
+        const BatchRangeSegment *segment = &range->segments[i];
+        uint32_t segment_end = segment->first + segment->count;
+        if (segment_end <= first || segment->first >= end)
+        {
+            continue;
+        }
+        
+        // Overlap of [first, end) with this segment
+        uint32_t begin = first > segment->first ? first : segment->first;
+        uint32_t stop = end < segment_end ? end : segment_end;
+        uint32_t source = begin - first;
+        
+        uint8_t *records = segment->instances + (size_t)(begin - segment->first) * range->instance_size;
+        write_quad_records(records, range->format, &range->pack,
+                           positions + source, sizes + source, colors + source, stop - begin);
+    }
+}
+
+void batch_renderer_2d_end(BatchRenderer2D *renderer)
+{
+    if (!renderer || !renderer->in_batch)
+    {
+        return;
+    }
     
-    SDL_GPUBufferBinding index_binding = {0};
-    index_binding.buffer = renderer->index_buffer;
-    index_binding.offset = 0;
+    renderer->in_batch = false;
+    renderer->total_submitted_quads += renderer->quad_count;
+    renderer->total_culled_quads += renderer->culled_quads;
     
-    SDL_BindGPUIndexBuffer(render_pass, &index_binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
+    if (renderer->dropped_quads > 0 && renderer->memory_cap_hit)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Batch renderer hit its %llu byte memory cap, dropped %u quads",
+                    (unsigned long long)renderer->memory_cap, renderer->dropped_quads);
+    }
+    else if (renderer->dropped_quads > 0)
+    {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Batch renderer failed to allocate or map a chunk, dropped %u quads",
+                    renderer->dropped_quads);
+    }
+    
+    for (uint32_t i = 0; i < renderer->active_chunk_count; i++)
+    {
+        BatchChunk *chunk = &renderer->chunks[i];
+        SDL_UnmapGPUTransferBuffer(renderer->device, chunk->staging_buffer);
+        chunk->instances = NULL;
+        
+        if (chunk->quad_count == 0)
+        {
+            continue;
+        }
+        
+        // Queue the copy, it is recorded at the start of the frame's command buffer
+        uint32_t upload_size = chunk->quad_count * renderer->instance_size;
+        if (!upload_queue_enqueue_transfer(renderer->upload_queue, chunk->staging_buffer, 0,
+                                           chunk->instance_buffer, 0, upload_size))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to upload batch instance data");
+        }
+    }
+}
+
+void batch_renderer_2d_draw(BatchRenderer2D *renderer, SDL_GPURenderPass *render_pass)
+{
+    if (!renderer || !render_pass || renderer->quad_count == 0)
+    {
+        return;
+    }
     
-    uint32_t num_indices = renderer->quad_count * 6;
-    SDL_DrawGPUIndexedPrimitives(render_pass, num_indices, 1, 0, 0, 0);
+    // One draw per chunk
+    for (uint32_t i = 0; i < renderer->active_chunk_count; i++)
+    {
+        BatchChunk *chunk = &renderer->chunks[i];
+        if (chunk->quad_count == 0)
+        {
+            continue;
+        }
+        
+        SDL_GPUBufferBinding instance_binding = {0};
+        instance_binding.buffer = chunk->instance_buffer;
+        instance_binding.offset = 0;
+        
+        SDL_BindGPUVertexBuffers(render_pass, 0, &instance_binding, 1);
+        
+        SDL_DrawGPUPrimitives(render_pass, QUAD_INSTANCE_VERTICES, chunk->quad_count, 0, 0);
+    }
+}
+
+void batch_renderer_2d_submit(BatchRenderer2D *renderer, RenderQueue *queue, RenderKey key)
+{
+    if (!renderer || !queue || renderer->quad_count == 0)
+    {
+        return;
+    }
+    
+    for (uint32_t i = 0; i < renderer->active_chunk_count; i++)
+    {
+        BatchChunk *chunk = &renderer->chunks[i];
+        if (chunk->quad_count > 0)
+        {
+            render_queue_submit(queue, key, chunk->instance_buffer, QUAD_INSTANCE_VERTICES, 0, chunk->quad_count);
+        }
+    }
 }
\ No newline at end of file
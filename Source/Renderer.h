@@ -5,36 +5,179 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "Math.h"
+#include "Buffers.h"
+#include "QuadPack.h"
+#include "RenderQueue.h"
 
-// Maximum number of quads in a single batch
-#define MAX_QUADS 1000000
-#define MAX_VERTICES (MAX_QUADS * 4)
-#define MAX_INDICES (MAX_QUADS * 6)
+// The first chunk holds this many quads, each new chunk doubles up to the max
+#define BATCH_INITIAL_CHUNK_QUADS 1024
+#define BATCH_MAX_CHUNK_QUADS 65536
 
-typedef struct Vertex2D
+// Bulk submission converts this many quads at a time on the stack
+#define BATCH_PACK_BLOCK_QUADS 256
+
+// A reserved range can span this many chunks, larger requests get a shorter range
+#define BATCH_RANGE_MAX_SEGMENTS 32
+
+// Default cap on GPU + staging memory across all chunks
+#define BATCH_DEFAULT_MEMORY_CAP (256 * 1024 * 1024)
+
+// Vertices per instance, the vertex shader expands each quad from gl_VertexIndex
+#define QUAD_INSTANCE_VERTICES 6
+
+typedef enum BatchVertexFormat
+{
+    BATCH_VERTEX_FORMAT_FULL,    // QuadInstance, drawn with 2d.vert
+    BATCH_VERTEX_FORMAT_COMPACT, // CompactQuadInstance, drawn with 2d_compact.vert
+    BATCH_VERTEX_FORMAT_SHAPE,   // ShapeInstance, drawn with 2d_shape.vert and 2d_shape.frag
+    BATCH_VERTEX_FORMAT_COUNT
+} BatchVertexFormat;
+
+// One record per quad (must match 2d.vert instance inputs)
+typedef struct QuadInstance
 {
     Vector2f position;
-    Vector4f color;
-} Vertex2D;
+    Vector2f size;
+    uint32_t color; // RGBA8, red in the lowest byte
+} QuadInstance;
+
+// Half-float position and size, must match 2d_compact.vert instance inputs
+typedef struct CompactQuadInstance
+{
+    uint16_t position[2];
+    uint16_t size[2];
+    uint32_t color; // RGBA8, red in the lowest byte
+} CompactQuadInstance;
+
+// Evaluated per pixel in 2d_shape.frag, values must match the SHAPE_* constants there
+typedef enum ShapeType
+{
+    SHAPE_TYPE_QUAD,
+    SHAPE_TYPE_CIRCLE,
+    SHAPE_TYPE_ROUNDED_RECT,
+    SHAPE_TYPE_LINE
+} ShapeType;
+
+// A quad that covers one analytic shape, must match 2d_shape.vert instance inputs.
+// params.x: outline width (line thickness for lines), 0 fills the shape
+// params.y: corner radius of rounded rects
+// params.zw: half of the line segment, centered on position
+typedef struct ShapeInstance
+{
+    Vector2f position;
+    Vector2f size;
+    uint32_t color; // RGBA8, red in the lowest byte
+    uint32_t shape;
+    Vector4f params;
+} ShapeInstance;
+
+// Largest record of any format, enough for a copy of a single record on the stack
+#define BATCH_VERTEX_FORMAT_MAX_SIZE sizeof(ShapeInstance)
+
+// Quads are written straight into staging_buffer, it is mapped (and cycled) when the
+// chunk is first used in a batch and copied into instance_buffer by the upload queue
+typedef struct BatchChunk
+{
+    SDL_GPUBuffer *instance_buffer;
+    SDL_GPUTransferBuffer *staging_buffer;
+    uint8_t *instances;
+    uint32_t capacity;
+    uint32_t quad_count;
+} BatchChunk;
+
+typedef struct BatchRangeSegment
+{
+    uint8_t *instances;
+    uint32_t first; // index of the segment's first quad within the range
+    uint32_t count;
+} BatchRangeSegment;
+
+// Contiguous quads reserved in draw order. The range only points into mapped chunk
+// memory, so any thread can fill it without touching the renderer
+typedef struct BatchRange
+{
+    BatchVertexFormat format;
+    uint32_t instance_size;
+    QuadPackFunctions pack;
+    BatchRangeSegment segments[BATCH_RANGE_MAX_SEGMENTS];
+    uint32_t segment_count;
+    uint32_t count;
+} BatchRange;
 
 typedef struct BatchRenderer2D
 {
     SDL_GPUDevice *device;
-    SDL_GPUBuffer *vertex_buffer;
-    SDL_GPUBuffer *index_buffer;
+    UploadQueue *upload_queue;
+    BatchVertexFormat format;
+    uint32_t instance_size;
+    QuadPackFunctions pack;
     
-    Vertex2D *vertices;
-    uint32_t vertex_count;
+    // Chunks are kept between frames, a batch fills them in order and draws one per chunk
+    BatchChunk *chunks;
+    uint32_t chunk_count;
+    uint32_t chunk_capacity;
+    uint32_t active_chunk_count;
+    
+    uint64_t memory_used;
+    uint64_t memory_cap;
     uint32_t quad_count;
+    uint32_t dropped_quads;
+    bool memory_cap_hit; // this batch's drops come from the cap, not a failed chunk allocation or map
+    
+    // Quads outside cull_rect are rejected before they are packed
+    Rect2f cull_rect;
+    bool cull_enabled;
+    uint32_t culled_quads;
+    uint64_t total_submitted_quads;
+    uint64_t total_culled_quads;
+    
+    // Guards chunk growth so workers can reserve ranges concurrently
+    SDL_Mutex *reserve_mutex;
     
     bool in_batch;
 } BatchRenderer2D;
 
-bool batch_renderer_2d_init(BatchRenderer2D *renderer, SDL_GPUDevice *device);
+bool batch_renderer_2d_init(BatchRenderer2D *renderer, SDL_GPUDevice *device, UploadQueue *upload_queue, BatchVertexFormat format);
 void batch_renderer_2d_destroy(BatchRenderer2D *renderer);
+
+// Quads past the cap are dropped, chunks that already exist are kept
+void batch_renderer_2d_set_memory_cap(BatchRenderer2D *renderer, uint64_t memory_cap);
+
+// World-space visible area, quads whose bounds miss it are skipped by add_quad(s).
+// Reserved ranges are not culled
+void batch_renderer_2d_set_cull_rect(BatchRenderer2D *renderer, Rect2f cull_rect);
+void batch_renderer_2d_disable_culling(BatchRenderer2D *renderer);
 void batch_renderer_2d_begin(BatchRenderer2D *renderer);
 void batch_renderer_2d_add_quad(BatchRenderer2D *renderer, Vector2f position, Vector2f size, Vector4f color);
+
+// Anti-aliased shapes drawn as one quad each, only recorded by BATCH_VERTEX_FORMAT_SHAPE
+// renderers. An outline of 0 fills the shape
+void batch_renderer_2d_add_circle(BatchRenderer2D *renderer, Vector2f center, float radius, float outline, Vector4f color);
+void batch_renderer_2d_add_rounded_rect(BatchRenderer2D *renderer, Vector2f position, Vector2f size, float corner_radius, float outline, Vector4f color);
+void batch_renderer_2d_add_line(BatchRenderer2D *renderer, Vector2f start, Vector2f end, float thickness, Vector4f color);
+
+// Structure-of-arrays bulk submission, one call per run of quads instead of one per quad
+void batch_renderer_2d_add_quads(BatchRenderer2D *renderer, const Vector2f *positions, const Vector2f *sizes, const Vector4f *colors, uint32_t count);
+
+// Draw order follows reservation order: reserve ranges on one thread and hand them out for a
+// deterministic result. Reserving is thread safe, add_quad(s) must not run at the same time.
+// Every reserved quad has to be written before batch_renderer_2d_end
+BatchRange batch_renderer_2d_reserve(BatchRenderer2D *renderer, uint32_t count);
+void batch_range_write_quads(const BatchRange *range, uint32_t first, const Vector2f *positions, const Vector2f *sizes, const Vector4f *colors, uint32_t count);
 void batch_renderer_2d_end(BatchRenderer2D *renderer);
 void batch_renderer_2d_draw(BatchRenderer2D *renderer, SDL_GPURenderPass *render_pass);
 
+// Queues one draw per chunk under key instead of drawing right away
+void batch_renderer_2d_submit(BatchRenderer2D *renderer, RenderQueue *queue, RenderKey key);
+
+uint32_t batch_vertex_format_size(BatchVertexFormat format);
+const char *batch_vertex_format_shader(BatchVertexFormat format);
+const char *batch_vertex_format_fragment_shader(BatchVertexFormat format);
+
+// Encodes one quad as an instance record of the given format
+void batch_vertex_format_write(BatchVertexFormat format, void *record, Vector2f position, Vector2f size, Vector4f color);
+
+uint32_t pack_color_rgba8(Vector4f color);
+uint16_t pack_half(float value);
+
 #endif
\ No newline at end of file
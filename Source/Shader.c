@@ -1,8 +1,22 @@
 #include "Shader.h"
 #include <spirv_cross/spirv_cross_c.h>
 #include <SDL3/SDL_log.h>
+#include <SDL3/SDL_error.h>
 
 #include <assert.h>
+#include <string.h>
+
+static bool name_has_suffix(const char *name, const char *suffix)
+{
+    if (!name)
+    {
+        return false;
+    }
+
+    size_t name_length = strlen(name);
+    size_t suffix_length = strlen(suffix);
+    return name_length >= suffix_length && strcmp(name + name_length - suffix_length, suffix) == 0;
+}
 
 ShaderBinary shader_load_from_binary(const char *filename)
 {
@@ -108,6 +122,82 @@ void shader_release(SDL_GPUDevice *device, Shader *shader)
     }
 }
 
+SDL_GPUComputePipeline *compute_pipeline_create(SDL_GPUDevice *device, const char *filename, uint32_t readonly_buffer_count,
+                                                uint32_t readwrite_buffer_count, uint32_t uniform_buffer_count, uint32_t threadcount)
+{
+    ShaderBinary compute_binary = shader_load_from_binary(filename);
+    if (!compute_binary.bytes)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load compute shader %s", filename);
+        return NULL;
+    }
+
+    SDL_GPUComputePipelineCreateInfo compute_pipeline_info = {0};
+    compute_pipeline_info.code = compute_binary.bytes;
+    compute_pipeline_info.code_size = compute_binary.size;
+    compute_pipeline_info.entrypoint = "main";
+    compute_pipeline_info.format = SDL_GPU_SHADERFORMAT_SPIRV;
+    compute_pipeline_info.num_readonly_storage_buffers = readonly_buffer_count;   // bound after the pipeline
+    compute_pipeline_info.num_readwrite_storage_buffers = readwrite_buffer_count; // bound via SDL_BeginGPUComputePass
+    compute_pipeline_info.num_uniform_buffers = uniform_buffer_count;             // pushed via SDL_PushGPUComputeUniformData
+    compute_pipeline_info.threadcount_x = threadcount;
+    compute_pipeline_info.threadcount_y = 1;
+    compute_pipeline_info.threadcount_z = 1;
+
+    SDL_GPUComputePipeline *pipeline = SDL_CreateGPUComputePipeline(device, &compute_pipeline_info);
+    free(compute_binary.bytes);
+
+    if (!pipeline)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create compute pipeline for %s: %s", filename, SDL_GetError());
+    }
+    return pipeline;
+}
+
+bool compute_pass_dispatch(SDL_GPUCommandBuffer *cmd, SDL_GPUComputePipeline *pipeline,
+                           SDL_GPUBuffer *const *readonly_buffers, uint32_t readonly_count,
+                           SDL_GPUBuffer *const *readwrite_buffers, uint32_t readwrite_count,
+                           SDL_GPUBuffer *indirect_buffer, uint32_t indirect_offset, uint32_t group_count)
+{
+    if (readwrite_count > COMPUTE_PASS_MAX_READWRITE_BUFFERS)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Compute pass takes at most %d readwrite buffers", COMPUTE_PASS_MAX_READWRITE_BUFFERS);
+        return false;
+    }
+
+    SDL_GPUStorageBufferReadWriteBinding readwrite_bindings[COMPUTE_PASS_MAX_READWRITE_BUFFERS] = {0};
+    for (uint32_t i = 0; i < readwrite_count; i++)
+    {
+        readwrite_bindings[i].buffer = readwrite_buffers[i];
+        readwrite_bindings[i].cycle = false;
+    }
+
+    SDL_GPUComputePass *compute_pass = SDL_BeginGPUComputePass(cmd, NULL, 0, readwrite_bindings, readwrite_count);
+    if (!compute_pass)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to begin compute pass: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_BindGPUComputePipeline(compute_pass, pipeline);
+    if (readonly_count > 0)
+    {
+        SDL_BindGPUComputeStorageBuffers(compute_pass, 0, readonly_buffers, readonly_count);
+    }
+
+    if (indirect_buffer)
+    {
+        SDL_DispatchGPUComputeIndirect(compute_pass, indirect_buffer, indirect_offset);
+    }
+    else
+    {
+        SDL_DispatchGPUCompute(compute_pass, group_count, 1, 1);
+    }
+
+    SDL_EndGPUComputePass(compute_pass);
+    return true;
+}
+
 ShaderReflectionInfo shader_reflect_spirv(const uint32_t *spirv_data, size_t size_in_bytes)
 {
     ShaderReflectionInfo info = {0};
@@ -243,12 +333,33 @@ ShaderReflectionInfo shader_reflect_spirv(const uint32_t *spirv_data, size_t siz
             spvc_basetype base_type = spvc_type_get_basetype(type_id);
             uint32_t vec_size = spvc_type_get_vector_size(type_id);
             uint32_t columns = spvc_type_get_columns(type_id);
+            const char *name = spvc_compiler_get_name(compiler, res.id);
 
             // Map SPIRV type to SDL GPU format
             SDL_GPUVertexElementFormat format = SDL_GPU_VERTEXELEMENTFORMAT_INVALID;
             uint32_t attribute_size = 0;
 
-            if (base_type == SPVC_BASETYPE_FP32 && columns == 1)
+            // Compact formats are opted into through the input name
+            if (base_type == SPVC_BASETYPE_FP32 && columns == 1 && name_has_suffix(name, "_half"))
+            {
+                switch (vec_size)
+                {
+                    case 2:
+                        format = SDL_GPU_VERTEXELEMENTFORMAT_HALF2;
+                        attribute_size = 4;
+                        break;
+                    case 4:
+                        format = SDL_GPU_VERTEXELEMENTFORMAT_HALF4;
+                        attribute_size = 8;
+                        break;
+                }
+            }
+            else if (base_type == SPVC_BASETYPE_FP32 && columns == 1 && vec_size == 4 && name_has_suffix(name, "_unorm8"))
+            {
+                format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM;
+                attribute_size = 4;
+            }
+            else if (base_type == SPVC_BASETYPE_FP32 && columns == 1)
             {
                 switch (vec_size)
                 {
@@ -334,6 +445,7 @@ ShaderReflectionInfo shader_reflect_spirv(const uint32_t *spirv_data, size_t siz
         }
 
         info.vertex_attribute_count = attr_count;
+        info.vertex_stride = offset;
         free(inputs);
     }
     
@@ -13,8 +13,10 @@ typedef struct ShaderReflectionInfo {
     size_t num_storage_textures;
     size_t num_storage_buffers;
 
+    // Float inputs named *_half use half floats, vec4 inputs named *_unorm8 use normalized RGBA8
     SDL_GPUVertexAttribute *vertex_attributes;
     uint32_t vertex_attribute_count;
+    uint32_t vertex_stride;
 } ShaderReflectionInfo;
 
 typedef struct ShaderBinary
@@ -34,4 +36,20 @@ Shader shader_create(SDL_GPUDevice *device, SDL_GPUShaderStage stage, const char
 void shader_release(SDL_GPUDevice *device, Shader *shader);
 ShaderReflectionInfo shader_reflect_spirv(const uint32_t *spirv_data, size_t size_in_bytes);
 
+// SDL caps the readwrite storage buffers of a compute pass at this many
+#define COMPUTE_PASS_MAX_READWRITE_BUFFERS 8
+
+// Readonly storage buffers are set 0, readwrite ones set 1 and uniforms set 2,
+// threadcount must match the shader's local_size_x
+SDL_GPUComputePipeline *compute_pipeline_create(SDL_GPUDevice *device, const char *filename, uint32_t readonly_buffer_count,
+                                                uint32_t readwrite_buffer_count, uint32_t uniform_buffer_count, uint32_t threadcount);
+
+// Records a single dispatch in its own compute pass, passes are the only ordering SDL gives
+// between dependent dispatches. Outputs are never cycled so later passes see the writes.
+// Dispatches from indirect_buffer at indirect_offset when it is set, otherwise group_count groups
+bool compute_pass_dispatch(SDL_GPUCommandBuffer *cmd, SDL_GPUComputePipeline *pipeline,
+                           SDL_GPUBuffer *const *readonly_buffers, uint32_t readonly_count,
+                           SDL_GPUBuffer *const *readwrite_buffers, uint32_t readwrite_count,
+                           SDL_GPUBuffer *indirect_buffer, uint32_t indirect_offset, uint32_t group_count);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "StaticBatch.h"
+
+#define STATIC_BATCH_REMOVED UINT32_MAX
+
+SDL_COMPILE_TIME_ASSERT(static_batch_full_record, sizeof(QuadInstance) <= BATCH_VERTEX_FORMAT_MAX_SIZE);
+SDL_COMPILE_TIME_ASSERT(static_batch_compact_record, sizeof(CompactQuadInstance) <= BATCH_VERTEX_FORMAT_MAX_SIZE);
+SDL_COMPILE_TIME_ASSERT(static_batch_shape_record, sizeof(ShapeInstance) <= BATCH_VERTEX_FORMAT_MAX_SIZE);
+
+static bool static_batch_2d_grow(StaticBatch2D *batch, uint32_t new_capacity)
+{
+    if (new_capacity > STATIC_QUAD_HANDLE_SLOT_MASK)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Static batch cannot hold more than %u quads", STATIC_QUAD_HANDLE_SLOT_MASK);
+        return false;
+    }
+
+    SDL_GPUBufferCreateInfo buffer_info = {0};
+    buffer_info.usage = SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;
+    buffer_info.size = new_capacity * batch->instance_size;
+
+    SDL_GPUBuffer *instance_buffer = SDL_CreateGPUBuffer(batch->device, &buffer_info);
+    if (!instance_buffer)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create static batch buffer: %s", SDL_GetError());
+        return false;
+    }
+
+    ShadowBuffer shadow;
+    if (!shadow_buffer_create(&shadow, batch->device, instance_buffer, 0, buffer_info.size))
+    {
+        SDL_ReleaseGPUBuffer(batch->device, instance_buffer);
+        return false;
+    }
+
+    uint32_t *handle_records = (uint32_t *)SDL_realloc(batch->handle_records, new_capacity * sizeof(uint32_t));
+    if (handle_records)
+    {
+        batch->handle_records = handle_records;
+    }
+    uint32_t *record_handles = (uint32_t *)SDL_realloc(batch->record_handles, new_capacity * sizeof(uint32_t));
+    if (record_handles)
+    {
+        batch->record_handles = record_handles;
+    }
+    uint32_t *free_handles = (uint32_t *)SDL_realloc(batch->free_handles, new_capacity * sizeof(uint32_t));
+    if (free_handles)
+    {
+        batch->free_handles = free_handles;
+    }
+    uint8_t *handle_generations = (uint8_t *)SDL_realloc(batch->handle_generations, new_capacity * sizeof(uint8_t));
+    if (handle_generations)
+    {
+        batch->handle_generations = handle_generations;
+        SDL_memset(handle_generations + batch->capacity, 0, new_capacity - batch->capacity);
+    }
+
+    if (!handle_records || !record_handles || !free_handles || !handle_generations)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to grow static batch handle tables");
+        shadow_buffer_destroy(&shadow);
+        SDL_ReleaseGPUBuffer(batch->device, instance_buffer);
+        return false;
+    }
+
+    // The new buffer starts empty, so every live record is uploaded again
+    if (batch->quad_count > 0)
+    {
+        shadow_buffer_write(&shadow, 0, batch->shadow.data, batch->quad_count * batch->instance_size);
+        batch->dirty = true;
+    }
+
+    // Releasing is deferred by SDL until frames still drawing from the old buffer retire
+    shadow_buffer_destroy(&batch->shadow);
+    if (batch->instance_buffer)
+    {
+        SDL_ReleaseGPUBuffer(batch->device, batch->instance_buffer);
+    }
+
+    batch->instance_buffer = instance_buffer;
+    batch->shadow = shadow;
+    batch->capacity = new_capacity;
+    return true;
+}
+
+bool static_batch_2d_create(StaticBatch2D *batch, SDL_GPUDevice *device, UploadQueue *upload_queue, BatchVertexFormat format, uint32_t initial_capacity)
+{
+    if (!batch || !device)
+    {
+        return false;
+    }
+
+    SDL_memset(batch, 0, sizeof(StaticBatch2D));
+    batch->device = device;
+    batch->upload_queue = upload_queue;
+    batch->format = format;
+    batch->instance_size = batch_vertex_format_size(format);
+
+    if (!static_batch_2d_grow(batch, initial_capacity > 0 ? initial_capacity : STATIC_BATCH_DEFAULT_CAPACITY))
+    {
+        static_batch_2d_destroy(batch);
+        return false;
+    }
+
+    return true;
+}
+
+void static_batch_2d_destroy(StaticBatch2D *batch)
+{
+    if (!batch || !batch->device)
+    {
+        return;
+    }
+
+    shadow_buffer_destroy(&batch->shadow);
+    if (batch->instance_buffer)
+    {
+        SDL_ReleaseGPUBuffer(batch->device, batch->instance_buffer);
+    }
+
+    SDL_free(batch->handle_records);
+    SDL_free(batch->record_handles);
+    SDL_free(batch->free_handles);
+    SDL_free(batch->handle_generations);
+    SDL_memset(batch, 0, sizeof(StaticBatch2D));
+}
+
+static bool static_batch_2d_write(StaticBatch2D *batch, uint32_t record, Vector2f position, Vector2f size, Vector4f color)
+{
+    uint8_t instance[BATCH_VERTEX_FORMAT_MAX_SIZE];
+    batch_vertex_format_write(batch->format, instance, position, size, color);
+
+    // The shadow drops bytes that did not change, rewriting the same quad uploads nothing
+    shadow_buffer_write(&batch->shadow, record * batch->instance_size, instance, batch->instance_size);
+    batch->dirty = batch->shadow.range_count > 0;
+    return true;
+}
+
+StaticQuadHandle static_batch_2d_add(StaticBatch2D *batch, Vector2f position, Vector2f size, Vector4f color)
+{
+    if (!batch || !batch->device)
+    {
+        return STATIC_QUAD_HANDLE_INVALID;
+    }
+
+    if (batch->quad_count == batch->capacity && !static_batch_2d_grow(batch, batch->capacity * 2))
+    {
+        return STATIC_QUAD_HANDLE_INVALID;
+    }
+
+    uint32_t slot = batch->free_handle_count > 0
+        ? batch->free_handles[--batch->free_handle_count]
+        : ++batch->handle_count;
+
+    uint32_t record = batch->quad_count++;
+    batch->handle_records[slot - 1] = record;
+    batch->record_handles[record] = slot;
+
+    static_batch_2d_write(batch, record, position, size, color);
+    return ((StaticQuadHandle)batch->handle_generations[slot - 1] << STATIC_QUAD_HANDLE_SLOT_BITS) | slot;
+}
+
+// Slot of a live handle, 0 when the handle was removed, cleared or never handed out
+static uint32_t static_batch_2d_live_slot(StaticBatch2D *batch, StaticQuadHandle handle)
+{
+    if (!batch || !batch->device)
+    {
+        return 0;
+    }
+
+    uint32_t slot = handle & STATIC_QUAD_HANDLE_SLOT_MASK;
+    if (slot == 0 || slot > batch->handle_count || batch->handle_records[slot - 1] == STATIC_BATCH_REMOVED ||
+        batch->handle_generations[slot - 1] != handle >> STATIC_QUAD_HANDLE_SLOT_BITS)
+    {
+        return 0;
+    }
+    return slot;
+}
+
+bool static_batch_2d_update(StaticBatch2D *batch, StaticQuadHandle handle, Vector2f position, Vector2f size, Vector4f color)
+{
+    uint32_t slot = static_batch_2d_live_slot(batch, handle);
+    if (slot == 0)
+    {
+        return false;
+    }
+
+    return static_batch_2d_write(batch, batch->handle_records[slot - 1], position, size, color);
+}
+
+void static_batch_2d_remove(StaticBatch2D *batch, StaticQuadHandle handle)
+{
+    uint32_t slot = static_batch_2d_live_slot(batch, handle);
+    if (slot == 0)
+    {
+        return;
+    }
+
+    uint32_t record = batch->handle_records[slot - 1];
+    uint32_t last = batch->quad_count - 1;
+
+    // Move the last quad into the hole so the live records stay contiguous
+    if (record != last)
+    {
+        shadow_buffer_write(&batch->shadow, record * batch->instance_size,
+                            batch->shadow.data + last * batch->instance_size, batch->instance_size);
+
+        uint32_t moved = batch->record_handles[last];
+        batch->record_handles[record] = moved;
+        batch->handle_records[moved - 1] = record;
+        batch->dirty = batch->shadow.range_count > 0;
+    }
+
+    batch->handle_records[slot - 1] = STATIC_BATCH_REMOVED;
+    batch->handle_generations[slot - 1]++;
+    batch->free_handles[batch->free_handle_count++] = slot;
+    batch->quad_count--;
+}
+
+void static_batch_2d_clear(StaticBatch2D *batch)
+{
+    if (!batch)
+    {
+        return;
+    }
+
+    // Every handle handed out so far goes stale, its slot comes back with a new generation
+    for (uint32_t i = 0; i < batch->handle_count; i++)
+    {
+        batch->handle_generations[i]++;
+    }
+
+    batch->quad_count = 0;
+    batch->handle_count = 0;
+    batch->free_handle_count = 0;
+}
+
+void static_batch_2d_flush(StaticBatch2D *batch)
+{
+    if (!batch || !batch->dirty)
+    {
+        return;
+    }
+
+    shadow_buffer_flush(&batch->shadow, batch->upload_queue);
+    batch->dirty = false;
+}
+
+void static_batch_2d_draw(StaticBatch2D *batch, SDL_GPURenderPass *render_pass)
+{
+    if (!batch || !render_pass || batch->quad_count == 0)
+    {
+        return;
+    }
+
+    SDL_GPUBufferBinding instance_binding = {0};
+    instance_binding.buffer = batch->instance_buffer;
+    instance_binding.offset = 0;
+
+    SDL_BindGPUVertexBuffers(render_pass, 0, &instance_binding, 1);
+    SDL_DrawGPUPrimitives(render_pass, QUAD_INSTANCE_VERTICES, batch->quad_count, 0, 0);
+}
+
+void static_batch_2d_submit(StaticBatch2D *batch, RenderQueue *queue, RenderKey key)
+{
+    if (!batch || !queue || batch->quad_count == 0)
+    {
+        return;
+    }
+
+    render_queue_submit(queue, key, batch->instance_buffer, QUAD_INSTANCE_VERTICES, 0, batch->quad_count);
+}
\ No newline at end of file
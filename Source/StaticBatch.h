@@ -0,0 +1,61 @@
+#ifndef _STATIC_BATCH_H
+#define _STATIC_BATCH_H
+
+#include <SDL3/SDL.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "Math.h"
+#include "Buffers.h"
+#include "Renderer.h"
+#include "RenderQueue.h"
+
+// Handles stay valid until their quad is removed or the batch is cleared, 0 is never a valid
+// handle. The low bits are the handle slot, the high bits the slot generation, so a stale
+// handle is rejected even after its slot has been handed out again
+typedef uint32_t StaticQuadHandle;
+#define STATIC_QUAD_HANDLE_INVALID 0
+#define STATIC_QUAD_HANDLE_SLOT_BITS 24
+#define STATIC_QUAD_HANDLE_SLOT_MASK ((1u << STATIC_QUAD_HANDLE_SLOT_BITS) - 1)
+
+#define STATIC_BATCH_DEFAULT_CAPACITY 1024
+
+// Retained quads that live in their own instance buffer across frames. Records are kept
+// dense (removal moves the last quad into the hole) so the batch is always one draw, and
+// only bytes that actually changed are uploaded
+typedef struct StaticBatch2D
+{
+    SDL_GPUDevice *device;
+    UploadQueue *upload_queue;
+    BatchVertexFormat format;
+    uint32_t instance_size;
+
+    SDL_GPUBuffer *instance_buffer;
+    ShadowBuffer shadow;
+    uint32_t capacity;
+    uint32_t quad_count;
+
+    uint32_t *handle_records;     // slot - 1 -> record index, UINT32_MAX once removed
+    uint32_t *record_handles;     // record index -> slot
+    uint8_t *handle_generations;  // slot - 1 -> generation, bumped when the slot's quad goes away
+    uint32_t *free_handles;       // free slots
+    uint32_t free_handle_count;
+    uint32_t handle_count;
+
+    bool dirty;
+} StaticBatch2D;
+
+bool static_batch_2d_create(StaticBatch2D *batch, SDL_GPUDevice *device, UploadQueue *upload_queue, BatchVertexFormat format, uint32_t initial_capacity);
+void static_batch_2d_destroy(StaticBatch2D *batch);
+
+StaticQuadHandle static_batch_2d_add(StaticBatch2D *batch, Vector2f position, Vector2f size, Vector4f color);
+bool static_batch_2d_update(StaticBatch2D *batch, StaticQuadHandle handle, Vector2f position, Vector2f size, Vector4f color);
+void static_batch_2d_remove(StaticBatch2D *batch, StaticQuadHandle handle);
+void static_batch_2d_clear(StaticBatch2D *batch);
+
+// Queues the changed byte ranges, does nothing while the batch is clean
+void static_batch_2d_flush(StaticBatch2D *batch);
+
+void static_batch_2d_draw(StaticBatch2D *batch, SDL_GPURenderPass *render_pass);
+void static_batch_2d_submit(StaticBatch2D *batch, RenderQueue *queue, RenderKey key);
+
+#endif
\ No newline at end of file